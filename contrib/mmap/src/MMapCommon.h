@@ -26,6 +26,9 @@
 
 #include <string>
 #include <vector>
+#include <ctime>
+#include <sys/types.h>
+#include <sys/stat.h>
 
 #include "Platform/Define.h"
 
@@ -125,6 +128,16 @@ namespace MMAP
 
         return LISTFILE_OK;
     }
+
+    inline bool getFileModifiedTime(const char* fileName, time_t& modTime)
+    {
+        struct stat fileInfo;
+        if (stat(fileName, &fileInfo) != 0)
+            return false;
+
+        modTime = fileInfo.st_mtime;
+        return true;
+    }
 }
 
 #endif
@@ -21,6 +21,7 @@
 
 #include "MapTree.h"
 #include "ModelInstance.h"
+#include "VMapManager2.h"
 
 #include "DetourNavMeshBuilder.h"
 #include "DetourCommon.h"
@@ -31,10 +32,130 @@ using namespace VMAP;
 
 namespace MMAP
 {
+    TileWorkerPool::TileWorkerPool(uint32 threadCount) :
+        m_queued(0), m_pending(0), m_nextQueue(0), m_stop(false)
+    {
+        if (!threadCount)
+            threadCount = 1;
+
+        for (uint32 i = 0; i < threadCount; ++i)
+            m_queues.push_back(new WorkQueue());
+
+        for (uint32 i = 0; i < threadCount; ++i)
+            m_workers.push_back(std::thread(&TileWorkerPool::workerLoop, this, i));
+    }
+
+    /**************************************************************************/
+    TileWorkerPool::~TileWorkerPool()
+    {
+        wait();
+
+        {
+            std::lock_guard<std::mutex> guard(m_stateLock);
+            m_stop = true;
+        }
+        m_workCond.notify_all();
+
+        for (std::vector<std::thread>::iterator itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+            itr->join();
+
+        for (std::vector<WorkQueue*>::iterator itr = m_queues.begin(); itr != m_queues.end(); ++itr)
+            delete *itr;
+    }
+
+    /**************************************************************************/
+    void TileWorkerPool::enqueue(Task const& task)
+    {
+        ++m_pending;
+
+        // count the task before it becomes visible, so a worker can never pop it before it was counted
+        {
+            std::lock_guard<std::mutex> guard(m_stateLock);
+            ++m_queued;
+        }
+
+        // spread tasks over the worker queues, idle workers steal the rest
+        WorkQueue* queue = m_queues[m_nextQueue++ % m_queues.size()];
+        {
+            std::lock_guard<std::mutex> guard(queue->lock);
+            queue->tasks.push_back(task);
+        }
+
+        m_workCond.notify_one();
+    }
+
+    /**************************************************************************/
+    void TileWorkerPool::wait()
+    {
+        std::unique_lock<std::mutex> guard(m_stateLock);
+        m_doneCond.wait(guard, [this]() { return m_pending == 0; });
+    }
+
+    /**************************************************************************/
+    bool TileWorkerPool::popTask(uint32 workerId, Task& task)
+    {
+        // own queue first, newest task is the most likely to share cached data with the previous one
+        {
+            WorkQueue* queue = m_queues[workerId];
+            std::lock_guard<std::mutex> guard(queue->lock);
+            if (!queue->tasks.empty())
+            {
+                task = queue->tasks.back();
+                queue->tasks.pop_back();
+                return true;
+            }
+        }
+
+        // steal the oldest task of another worker
+        for (uint32 i = 1; i < m_queues.size(); ++i)
+        {
+            WorkQueue* queue = m_queues[(workerId + i) % m_queues.size()];
+            std::lock_guard<std::mutex> guard(queue->lock);
+            if (!queue->tasks.empty())
+            {
+                task = queue->tasks.front();
+                queue->tasks.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**************************************************************************/
+    void TileWorkerPool::workerLoop(uint32 workerId)
+    {
+        Task task;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> guard(m_stateLock);
+                m_workCond.wait(guard, [this]() { return m_stop || m_queued > 0; });
+                if (m_stop)
+                    return;
+            }
+
+            if (!popTask(workerId, task))
+                continue;                   // another worker was faster
+
+            --m_queued;
+            task();
+            task = Task();
+
+            if (--m_pending == 0)
+            {
+                std::lock_guard<std::mutex> guard(m_stateLock);
+                m_doneCond.notify_all();
+            }
+        }
+    }
+
+    /**************************************************************************/
     MapBuilder::MapBuilder(float maxWalkableAngle, bool skipLiquid,
                            bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-                           bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath) :
+                           bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath, uint32 threads) :
         m_terrainBuilder(NULL),
+        m_workerPool(NULL),
         m_debugOutput(debugOutput),
         m_skipContinents(skipContinents),
         m_skipJunkMaps(skipJunkMaps),
@@ -48,12 +169,17 @@ namespace MMAP
 
         m_rcContext = new rcContext(false);
 
+        m_workerPool = new TileWorkerPool(threads);
+
         discoverTiles();
     }
 
     /**************************************************************************/
     MapBuilder::~MapBuilder()
     {
+        // finish pending tiles before their data goes away
+        delete m_workerPool;
+
         for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
         {
             (*it).second->clear();
@@ -148,8 +274,11 @@ namespace MMAP
         {
             uint32 mapID = (*it).first;
             if (!shouldSkipMap(mapID))
-                buildMap(mapID);
+                queueMap(mapID);
         }
+
+        // tiles of all maps share the pool, so small maps are done while continents are still building
+        m_workerPool->wait();
     }
 
     /**************************************************************************/
@@ -206,12 +335,20 @@ namespace MMAP
             return;
         }
 
-        buildTile(mapID, tileX, tileY, navMesh, 1, 1);
+        MapBuildJob job(mapID, navMesh, 1);
+        buildTile(tileX, tileY, job);
         dtFreeNavMesh(navMesh);
     }
 
     /**************************************************************************/
     void MapBuilder::buildMap(uint32 mapID)
+    {
+        queueMap(mapID);
+        m_workerPool->wait();
+    }
+
+    /**************************************************************************/
+    void MapBuilder::queueMap(uint32 mapID)
     {
         printf("Building map %03u:                                    \n", mapID);
 
@@ -242,33 +379,59 @@ namespace MMAP
             return;
         }
 
-        // now start building mmtiles for each tile
-        printf("[Map %03i] We have %u tiles.                          \n", mapID, uint32(tiles->size()));
-
-        uint32 currentTile = 0;
+        // only tiles without an up to date mmtile are built again
+        std::vector<uint32> outdatedTiles;
         for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
         {
-            currentTile++;
             uint32 tileX, tileY;
 
             // unpack tile coords
             StaticMapTree::unpackTileID((*it), tileX, tileY);
 
-            if (shouldSkipTile(mapID, tileX, tileY))
-                continue;
+            if (!shouldSkipTile(mapID, tileX, tileY))
+                outdatedTiles.push_back(*it);
+        }
 
-            buildTile(mapID, tileX, tileY, navMesh, currentTile, uint32(tiles->size()));
+        // now start building mmtiles for each tile
+        printf("[Map %03i] We have %u tiles, %u to build.             \n", mapID, uint32(tiles->size()), uint32(outdatedTiles.size()));
+
+        MapBuildJob* job = new MapBuildJob(mapID, navMesh, uint32(outdatedTiles.size()));
+
+        // hold one reference while queueing so early finishing workers can't free the job
+        job->remainingTiles = uint32(outdatedTiles.size()) + 1;
+
+        for (std::vector<uint32>::const_iterator it = outdatedTiles.begin(); it != outdatedTiles.end(); ++it)
+        {
+            uint32 tileX, tileY;
+            StaticMapTree::unpackTileID((*it), tileX, tileY);
+
+            m_workerPool->enqueue([this, job, tileX, tileY]()
+            {
+                buildTile(tileX, tileY, *job);
+                finishTile(job);
+            });
         }
 
-        dtFreeNavMesh(navMesh);
+        finishTile(job);
+    }
 
-        printf("[Map %03i] Complete!                             \n\n", mapID);
+    /**************************************************************************/
+    void MapBuilder::finishTile(MapBuildJob* job)
+    {
+        if (--job->remainingTiles)
+            return;
+
+        dtFreeNavMesh(job->navMesh);
+
+        printf("[Map %03i] Complete!                             \n\n", job->mapID);
+        delete job;
     }
 
     /**************************************************************************/
-    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, uint32 curTile, uint32 tileCount)
+    void MapBuilder::buildTile(uint32 tileX, uint32 tileY, MapBuildJob& job)
     {
-        printf("[Map %03i] Building tile [%02u,%02u] (%02u / %02u)    \n", mapID, tileX, tileY, curTile, tileCount);
+        uint32 mapID = job.mapID;
+        printf("[Map %03i] Building tile [%02u,%02u] (%02u / %02u)    \n", mapID, tileX, tileY, uint32(++job.currentTile), job.tileCount);
 
         MeshData meshData;
 
@@ -301,7 +464,7 @@ namespace MMAP
         m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, job);
     }
 
     /**************************************************************************/
@@ -382,8 +545,10 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
                                       MeshData& meshData, float bmin[3], float bmax[3],
-                                      dtNavMesh* navMesh)
+                                      MapBuildJob& job)
     {
+        dtNavMesh* navMesh = job.navMesh;
+
         // console output
         char tileString[20];
         sprintf(tileString, "[Map %03i] [%02i,%02i]: ", mapID, tileX, tileY);
@@ -627,6 +792,7 @@ namespace MMAP
         params.walkableHeight = BASE_UNIT_DIM * config.walkableHeight;  // agent height
         params.walkableRadius = BASE_UNIT_DIM * config.walkableRadius;  // agent radius
         params.walkableClimb = BASE_UNIT_DIM * config.walkableClimb;    // keep less that walkableHeight (aka agent height)!
+        // navmesh params are never changed after init, reading them needs no lock
         params.tileX = (((bmin[0] + bmax[0]) / 2) - navMesh->getParams()->orig[0]) / GRID_SIZE;
         params.tileY = (((bmin[2] + bmax[2]) / 2) - navMesh->getParams()->orig[2]) / GRID_SIZE;
         rcVcopy(params.bmin, bmin);
@@ -685,6 +851,9 @@ namespace MMAP
                 continue;
             }
 
+            // tile is only added to check its data, detour navmesh is not thread safe
+            std::lock_guard<std::mutex> navMeshGuard(job.navMeshLock);
+
             dtTileRef tileRef = 0;
             printf("%s Adding tile to navmesh...                          \r", tileString);
             // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
@@ -848,7 +1017,47 @@ namespace MMAP
         if (header.mmapVersion != MMAP_VERSION)
             return false;
 
-        return true;
+        time_t tileTime;
+        if (!getFileModifiedTime(fileName, tileTime))
+            return false;
+
+        return !isTileOutdated(mapID, tileX, tileY, tileTime);
+    }
+
+    /**************************************************************************/
+    bool MapBuilder::isTileOutdated(uint32 mapID, uint32 tileX, uint32 tileY, time_t tileTime)
+    {
+        // a tile has to be rebuilt when any of the files it was generated from changed after it
+        std::vector<std::string> sources;
+
+        // terrain of the tile and the borders of its neighbours, see TerrainBuilder::loadMap
+        char fileName[255];
+        sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY, tileX);
+        sources.push_back(fileName);
+        sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY, tileX + 1);
+        sources.push_back(fileName);
+        sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY, tileX - 1);
+        sources.push_back(fileName);
+        sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY + 1, tileX);
+        sources.push_back(fileName);
+        sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY - 1, tileX);
+        sources.push_back(fileName);
+
+        // model data, see TerrainBuilder::loadVMap
+        sources.push_back(std::string("vmaps/") + VMapManager2::getMapFileName(mapID));
+        sources.push_back(std::string("vmaps/") + StaticMapTree::getTileFileName(mapID, tileY, tileX));
+
+        if (m_offMeshFilePath)
+            sources.push_back(m_offMeshFilePath);
+
+        for (std::vector<std::string>::const_iterator itr = sources.begin(); itr != sources.end(); ++itr)
+        {
+            time_t sourceTime;
+            if (getFileModifiedTime(itr->c_str(), sourceTime) && sourceTime > tileTime)
+                return true;
+        }
+
+        return false;
     }
 
 }
@@ -22,6 +22,12 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <condition_variable>
 
 #include "TerrainBuilder.h"
 #include "IntermediateValues.h"
@@ -57,6 +63,59 @@ namespace MMAP
         rcPolyMeshDetail* dmesh;
     };
 
+    // state shared by all tiles of one map while they are being built
+    struct MapBuildJob
+    {
+        MapBuildJob(uint32 _mapID, dtNavMesh* _navMesh, uint32 _tileCount) :
+            mapID(_mapID), navMesh(_navMesh), tileCount(_tileCount), currentTile(0), remainingTiles(0) {}
+
+        uint32 mapID;
+        dtNavMesh* navMesh;                 // only used to validate generated tile data, guarded by navMeshLock
+        std::mutex navMeshLock;
+        uint32 tileCount;
+        std::atomic<uint32> currentTile;
+        std::atomic<uint32> remainingTiles; // tiles queued but not yet finished, last one frees the job
+    };
+
+    // work stealing thread pool used to build tiles concurrently
+    // every worker pops tasks from the back of its own queue and steals from the front of the others when it runs dry
+    class TileWorkerPool
+    {
+        public:
+            typedef std::function<void()> Task;
+
+            explicit TileWorkerPool(uint32 threadCount);
+            ~TileWorkerPool();
+
+            uint32 getThreadCount() const { return uint32(m_queues.size()); }
+
+            void enqueue(Task const& task);
+
+            // blocks until all queued tasks are done
+            void wait();
+
+        private:
+            struct WorkQueue
+            {
+                std::mutex lock;
+                std::deque<Task> tasks;
+            };
+
+            void workerLoop(uint32 workerId);
+            bool popTask(uint32 workerId, Task& task);
+
+            std::vector<WorkQueue*> m_queues;
+            std::vector<std::thread> m_workers;
+
+            std::mutex m_stateLock;
+            std::condition_variable m_workCond;
+            std::condition_variable m_doneCond;
+            std::atomic<uint32> m_queued;       // tasks waiting in any queue
+            std::atomic<uint32> m_pending;      // tasks queued or running
+            std::atomic<uint32> m_nextQueue;
+            bool m_stop;
+    };
+
     class MapBuilder
     {
         public:
@@ -67,7 +126,8 @@ namespace MMAP
                        bool skipBattlegrounds   = false,
                        bool debugOutput         = false,
                        bool bigBaseUnit         = false,
-                       const char* offMeshFilePath = NULL);
+                       const char* offMeshFilePath = NULL,
+                       uint32 threads           = 1);
 
             ~MapBuilder();
 
@@ -87,7 +147,11 @@ namespace MMAP
 
             void buildNavMesh(uint32 mapID, dtNavMesh*& navMesh);
 
-            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, uint32 curTile, uint32 tileCount);
+            // creates the navmesh of the map and queues all its outdated tiles on the worker pool
+            void queueMap(uint32 mapID);
+            void finishTile(MapBuildJob* job);
+
+            void buildTile(uint32 tileX, uint32 tileY, MapBuildJob& job);
 
             // move map building
             void buildMoveMapTile(uint32 mapID,
@@ -96,7 +160,7 @@ namespace MMAP
                                   MeshData& meshData,
                                   float bmin[3],
                                   float bmax[3],
-                                  dtNavMesh* navMesh);
+                                  MapBuildJob& job);
 
             void getTileBounds(uint32 tileX, uint32 tileY,
                                float* verts, int vertCount,
@@ -106,10 +170,14 @@ namespace MMAP
             bool shouldSkipMap(uint32 mapID);
             bool isTransportMap(uint32 mapID);
             bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY);
+            bool isTileOutdated(uint32 mapID, uint32 tileX, uint32 tileY, time_t tileTime);
 
+            // terrain builder keeps no per tile state, it is shared read-only by all workers
             TerrainBuilder* m_terrainBuilder;
             TileList m_tiles;
 
+            TileWorkerPool* m_workerPool;
+
             bool m_debugOutput;
 
             const char* m_offMeshFilePath;
@@ -121,6 +189,7 @@ namespace MMAP
             bool m_bigBaseUnit;
 
             // build performance - not really used for now
+            // logs and timers are disabled so it can be shared between workers
             rcContext* m_rcContext;
     };
 }
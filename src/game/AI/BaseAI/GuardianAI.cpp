@@ -190,11 +190,7 @@ void GuardianAI::EnterEvadeMode()
     m_creature->TriggerEvadeEvents();
 
     // Handle Evade events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_EVADE)
-            ProcessEvent(*i);
-    }
+    ProcessEventsOfType(EVENT_T_EVADE);
 }
 
 Unit* GuardianAI::DoSelectLowestHpFriendly(float range, uint32 MinHPDiff, bool onlyInCombat) const
@@ -46,11 +46,7 @@ void TotemAI::EnterEvadeMode()
     m_creature->CombatStop(true);
 
     // Handle Evade events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_EVADE)
-            ProcessEvent(*i);
-    }
+    ProcessEventsOfType(EVENT_T_EVADE);
 }
 
 void TotemAI::UpdateAI(const uint32 diff)
@@ -69,6 +69,8 @@ void CreatureEventAI::GetAIInformation(ChatHandler& reader)
     if (sLog.HasLogFilter(LOG_FILTER_EVENT_AI_DEV))         // Give some more details if in EventAI Dev Mode
         return;
 
+    FlushEventTimers();
+
     reader.PSendSysMessage("Current events of this creature:");
     for (CreatureEventAIList::const_iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
     {
@@ -89,6 +91,11 @@ inline bool IsEventFlagsFitForNormalMap(uint8 eFlags)
 }
 
 CreatureEventAI::CreatureEventAI(Creature* creature) : CreatureAI(creature),
+    m_EventUpdateTime(EVENT_UPDATE_TIME),
+    m_EventDiff(0),
+    m_EventSkippedDiff(0),
+    m_NextEventTimer(0),
+    m_EventUpdateInCombat(false),
     m_Phase(0),
     m_DynamicMovement(false),
     m_HasOOCLoSEvent(false),
@@ -173,6 +180,38 @@ CreatureEventAI::CreatureEventAI(Creature* creature) : CreatureAI(creature),
                                  m_creature->GetEntry(), m_creature->GetGuidStr().c_str(), aiName.c_str());
         }
     }
+
+    // Bucket the events by type, so that hooks only walk the events they can trigger
+    // m_CreatureEventAIList is not resized after this point, so the pointers stay valid
+    m_EventsByType.reserve(m_CreatureEventAIList.size());
+    for (uint32 type = 0; type < EVENT_T_END; ++type)
+    {
+        m_EventTypeBegin[type] = uint16(m_EventsByType.size());
+        for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+            if (i->Event.event_type == type)
+                m_EventsByType.push_back(&*i);
+    }
+    m_EventTypeBegin[EVENT_T_END] = uint16(m_EventsByType.size());
+}
+
+void CreatureEventAI::ProcessEventsOfType(EventAI_Type type, Unit* actionInvoker, Creature* AIEventSender)
+{
+    for (uint32 i = m_EventTypeBegin[type]; i < m_EventTypeBegin[type + 1]; ++i)
+        ProcessEvent(*m_EventsByType[i], actionInvoker, AIEventSender);
+}
+
+void CreatureEventAI::FlushEventTimers()
+{
+    if (!m_EventSkippedDiff)
+        return;
+
+    // skipped updates can't have expired any timer, see UpdateAI
+    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        if (i->Time && !(i->Event.event_inverse_phase_mask & (1 << m_Phase)))
+            i->Time -= std::min(i->Time, m_EventSkippedDiff);
+
+    m_EventDiff -= m_EventSkippedDiff;
+    m_EventSkippedDiff = 0;
 }
 
 bool CreatureEventAI::IsTimerBasedEvent(EventAI_Type type) const
@@ -204,6 +243,31 @@ bool CreatureEventAI::IsTimerBasedEvent(EventAI_Type type) const
     }
 }
 
+// events whose condition can't pass while the creature is out of combat
+bool CreatureEventAI::IsCombatOnlyEvent(EventAI_Type type) const
+{
+    switch (type)
+    {
+        case EVENT_T_TIMER_IN_COMBAT:
+        case EVENT_T_HP:
+        case EVENT_T_MANA:
+        case EVENT_T_RANGE:
+        case EVENT_T_TARGET_HP:
+        case EVENT_T_TARGET_CASTING:
+        case EVENT_T_FRIENDLY_HP:
+        case EVENT_T_FRIENDLY_IS_CC:
+        case EVENT_T_TARGET_MANA:
+        case EVENT_T_TARGET_AURA:
+        case EVENT_T_TARGET_MISSING_AURA:
+        case EVENT_T_ENERGY:
+        case EVENT_T_SELECT_ATTACKING_TARGET:
+        case EVENT_T_FACING_TARGET:
+            return true;
+        default:
+            return false;
+    }
+}
+
 bool CreatureEventAI::IsRepeatableEvent(EventAI_Type type) const
 {
     switch (type)
@@ -221,6 +285,8 @@ bool CreatureEventAI::IsRepeatableEvent(EventAI_Type type) const
 
 bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& holder, Unit* actionInvoker, Creature* AIEventSender /*=nullptr*/)
 {
+    FlushEventTimers();
+
     if (!holder.Enabled || holder.Time)
         return false;
 
@@ -539,6 +605,9 @@ bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& holder, Unit* actionIn
             break;
     }
 
+    // the event restarts its timer or gets disabled and its actions can change timers and phase
+    m_NextEventTimer = 0;
+
     // Disable non-repeatable events
     if (IsRepeatableEvent(holder.Event.event_type) && !(holder.Event.event_flags & EFLAG_REPEATABLE))
         holder.Enabled = false;
@@ -1246,6 +1315,8 @@ void CreatureEventAI::ProcessAction(CreatureEventAI_Action const& action, uint32
 
 void CreatureEventAI::JustRespawned()                       // NOTE that this is called from the AI's constructor as well
 {
+    ForceEventUpdate();
+
     m_EventUpdateTime = EVENT_UPDATE_TIME;
     m_EventDiff = 0;
     m_throwAIEventStep = 0;
@@ -1277,6 +1348,8 @@ void CreatureEventAI::JustRespawned()                       // NOTE that this is
 
 void CreatureEventAI::Reset()
 {
+    ForceEventUpdate();
+
     m_EventUpdateTime = EVENT_UPDATE_TIME;
     m_EventDiff = 0;
     m_throwAIEventStep = 0;
@@ -1307,11 +1380,7 @@ void CreatureEventAI::Reset()
 
 void CreatureEventAI::JustReachedHome()
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_REACHED_HOME)
-            ProcessEvent(*i);
-    }
+    ProcessEventsOfType(EVENT_T_REACHED_HOME);
 
     Reset();
 }
@@ -1327,11 +1396,7 @@ void CreatureEventAI::EnterEvadeMode()
     CreatureAI::EnterEvadeMode();
 
     // Handle Evade events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_EVADE)
-            ProcessEvent(*i);
-    }
+    ProcessEventsOfType(EVENT_T_EVADE);
 }
 
 void CreatureEventAI::JustDied(Unit* killer)
@@ -1349,13 +1414,10 @@ void CreatureEventAI::JustDied(Unit* killer)
         SendAIEventAround(AI_EVENT_JUST_DIED, killer, 0, AIEVENT_DEFAULT_THROW_RADIUS);
 
     // Handle On Death events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_DEATH)
-            ProcessEvent(*i, killer);
-    }
+    ProcessEventsOfType(EVENT_T_DEATH, killer);
 
     // reset phase after any death state events
+    ForceEventUpdate();
     m_Phase = 0;
 }
 
@@ -1364,54 +1426,40 @@ void CreatureEventAI::KilledUnit(Unit* victim)
     if (victim->GetTypeId() != TYPEID_PLAYER)
         return;
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_KILL)
-            ProcessEvent(*i, victim);
-    }
+    ProcessEventsOfType(EVENT_T_KILL, victim);
 }
 
 void CreatureEventAI::JustSummoned(Creature* summoned)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_SUMMONED_UNIT)
-            ProcessEvent(*i, summoned);
-    }
+    ProcessEventsOfType(EVENT_T_SUMMONED_UNIT, summoned);
 }
 
 void CreatureEventAI::SummonedCreatureJustDied(Creature* summoned)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_SUMMONED_JUST_DIED)
-            ProcessEvent(*i, summoned);
-    }
+    ProcessEventsOfType(EVENT_T_SUMMONED_JUST_DIED, summoned);
 }
 
 void CreatureEventAI::SummonedCreatureDespawn(Creature* summoned)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if (i->Event.event_type == EVENT_T_SUMMONED_JUST_DESPAWN)
-            ProcessEvent(*i, summoned);
-    }
+    ProcessEventsOfType(EVENT_T_SUMMONED_JUST_DESPAWN, summoned);
 }
 
 void CreatureEventAI::ReceiveAIEvent(AIEventType eventType, Creature* sender, Unit* invoker, uint32 /*miscValue*/)
 {
     MANGOS_ASSERT(sender);
 
-    for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    for (uint32 i = m_EventTypeBegin[EVENT_T_RECEIVE_AI_EVENT]; i < m_EventTypeBegin[EVENT_T_RECEIVE_AI_EVENT + 1]; ++i)
     {
-        if (itr->Event.event_type == EVENT_T_RECEIVE_AI_EVENT &&
-                itr->Event.receiveAIEvent.eventType == eventType && (!itr->Event.receiveAIEvent.senderEntry || itr->Event.receiveAIEvent.senderEntry == sender->GetEntry()))
-            ProcessEvent(*itr, invoker, sender);
+        CreatureEventAIHolder& holder = *m_EventsByType[i];
+        if (holder.Event.receiveAIEvent.eventType == eventType && (!holder.Event.receiveAIEvent.senderEntry || holder.Event.receiveAIEvent.senderEntry == sender->GetEntry()))
+            ProcessEvent(holder, invoker, sender);
     }
 }
 
 void CreatureEventAI::EnterCombat(Unit* enemy)
 {
+    ForceEventUpdate();
+
     // Check for on combat start events
     for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
     {
@@ -1448,21 +1496,20 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
     // Check for OOC LOS Event
     if (m_HasOOCLoSEvent && !m_creature->getVictim())
     {
-        for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+        for (uint32 i = m_EventTypeBegin[EVENT_T_OOC_LOS]; i < m_EventTypeBegin[EVENT_T_OOC_LOS + 1]; ++i)
         {
-            if (itr->Event.event_type == EVENT_T_OOC_LOS)
-            {
-                // can trigger if closer than fMaxAllowedRange
-                float fMaxAllowedRange = (float)itr->Event.ooc_los.maxRange;
+            CreatureEventAIHolder& holder = *m_EventsByType[i];
 
-                // if friendly event && who is not hostile OR hostile event && who is hostile
-                if ((itr->Event.ooc_los.noHostile && !m_creature->IsEnemy(who)) ||
-                        ((!itr->Event.ooc_los.noHostile) && m_creature->IsEnemy(who)))
-                {
-                    // if range is ok and we are actually in LOS
-                    if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
-                        ProcessEvent(*itr, who);
-                }
+            // can trigger if closer than fMaxAllowedRange
+            float fMaxAllowedRange = (float)holder.Event.ooc_los.maxRange;
+
+            // if friendly event && who is not hostile OR hostile event && who is hostile
+            if ((holder.Event.ooc_los.noHostile && !m_creature->IsEnemy(who)) ||
+                    ((!holder.Event.ooc_los.noHostile) && m_creature->IsEnemy(who)))
+            {
+                // if range is ok and we are actually in LOS
+                if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
+                    ProcessEvent(holder, who);
             }
         }
     }
@@ -1472,12 +1519,14 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
 
 void CreatureEventAI::SpellHit(Unit* pUnit, const SpellEntry* spellInfo)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-        if (i->Event.event_type == EVENT_T_SPELLHIT)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!i->Event.spell_hit.spellId || spellInfo->Id == i->Event.spell_hit.spellId)
-                if (spellInfo->SchoolMask & i->Event.spell_hit.schoolMask)
-                    ProcessEvent(*i, pUnit);
+    for (uint32 i = m_EventTypeBegin[EVENT_T_SPELLHIT]; i < m_EventTypeBegin[EVENT_T_SPELLHIT + 1]; ++i)
+    {
+        CreatureEventAIHolder& holder = *m_EventsByType[i];
+        // If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!holder.Event.spell_hit.spellId || spellInfo->Id == holder.Event.spell_hit.spellId)
+            if (spellInfo->SchoolMask & holder.Event.spell_hit.schoolMask)
+                ProcessEvent(holder, pUnit);
+    }
 }
 
 void CreatureEventAI::UpdateAI(const uint32 diff)
@@ -1490,32 +1539,65 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
     {
         m_EventDiff += diff;
 
-        // Check for time based events
-        for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        // combat only events are not polled out of combat, so entering or leaving combat needs a full update
+        bool inCombat = m_creature->isInCombat();
+        if (inCombat != m_EventUpdateInCombat)
+        {
+            m_EventUpdateInCombat = inCombat;
+            m_NextEventTimer = 0;
+        }
+
+        // Nothing can trigger before the lowest running timer expires, keep the time for later
+        // Events triggering or hooks changing timers force the next update, see ForceEventUpdate
+        if (m_EventDiff < m_NextEventTimer)
+        {
+            m_EventSkippedDiff = m_EventDiff;
+            m_EventUpdateTime = EVENT_UPDATE_TIME;
+        }
+        else
         {
-            // Decrement Timers
-            if (i->Time)
+            m_EventSkippedDiff = 0;
+            m_NextEventTimer = std::numeric_limits<uint32>::max();
+
+            // Check for time based events
+            for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
             {
                 // Do not decrement timers if event cannot trigger in this phase
-                if (!(i->Event.event_inverse_phase_mask & (1 << m_Phase)))
+                if (i->Event.event_inverse_phase_mask & (1 << m_Phase))
+                    continue;
+
+                // Decrement Timers
+                if (i->Time)
                 {
                     if (i->Time > m_EventDiff)
                         i->Time -= m_EventDiff;
                     else
                         i->Time = 0;
                 }
-            }
 
-            // Skip processing of events that have time remaining or are disabled
-            if (!(i->Enabled) || i->Time)
-                continue;
+                // Skip processing of events that have time remaining or are disabled
+                if (!(i->Enabled) || i->Time)
+                {
+                    if (i->Time)
+                        m_NextEventTimer = std::min(m_NextEventTimer, i->Time);
+                    continue;
+                }
+
+                if (!IsTimerBasedEvent(i->Event.event_type))
+                    continue;
 
-            if (IsTimerBasedEvent(i->Event.event_type))
+                // can't trigger in the current combat state, don't keep polling it
+                if (inCombat ? i->Event.event_type == EVENT_T_TIMER_OOC : IsCombatOnlyEvent(i->Event.event_type))
+                    continue;
+
+                // conditional events are polled every update as long as they are enabled and not on cooldown
+                m_NextEventTimer = 0;
                 ProcessEvent(*i);
-        }
+            }
 
-        m_EventDiff = 0;
-        m_EventUpdateTime = EVENT_UPDATE_TIME;
+            m_EventDiff = 0;
+            m_EventUpdateTime = EVENT_UPDATE_TIME;
+        }
     }
     else
     {
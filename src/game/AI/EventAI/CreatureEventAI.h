@@ -763,14 +763,29 @@ class CreatureEventAI : public CreatureAI
     protected:
         bool IsTimerBasedEvent(EventAI_Type type) const;
         bool IsRepeatableEvent(EventAI_Type type) const;
+        bool IsCombatOnlyEvent(EventAI_Type type) const;
+
+        // Process all events of the given type, in database order
+        void ProcessEventsOfType(EventAI_Type type, Unit* actionInvoker = nullptr, Creature* AIEventSender = nullptr);
+        // Apply the time of skipped event updates to the timers, must be done before events are processed or timers are changed
+        void FlushEventTimers();
+        // Flush the timers and do a full event update at the next event update time, for any change of timers, phase or enabled events
+        void ForceEventUpdate() { FlushEventTimers(); m_NextEventTimer = 0; }
 
         uint32 m_EventUpdateTime;                           // Time between event updates
         uint32 m_EventDiff;                                 // Time between the last event call
+        uint32 m_EventSkippedDiff;                          // Part of m_EventDiff from event updates skipped because no timer could expire
+        uint32 m_NextEventTimer;                            // Lowest running timer at the last event update, 0 to force next update
+        bool   m_EventUpdateInCombat;                       // Combat state at the last event update, a change forces next update
 
         // Variables used by Events themselves
         typedef std::vector<CreatureEventAIHolder> CreatureEventAIList;
         CreatureEventAIList m_CreatureEventAIList;          // Holder for events (stores enabled, time, and eventid)
 
+        // Events sorted by type, the holders of one type are m_EventsByType[m_EventTypeBegin[type] .. m_EventTypeBegin[type + 1] - 1]
+        std::vector<CreatureEventAIHolder*> m_EventsByType;
+        uint16 m_EventTypeBegin[EVENT_T_END + 1];
+
         uint8  m_Phase;                                     // Current phase, max 32 phases
         bool   m_DynamicMovement;                           // Core will control creatures movement if this is enabled
         bool   m_HasOOCLoSEvent;                            // Cache if a OOC-LoS Event exists
@@ -1321,9 +1321,9 @@ void BattleGround::EventPlayerLoggedOut(Player* player)
 void BattleGround::AddToBGFreeSlotQueue()
 {
     // make sure to add only once
-    if (!m_InBGFreeSlotQueue && isBattleGround())
+    if (!m_InBGFreeSlotQueue && isBattleGround() && m_BracketId != BG_BRACKET_ID_TEMPLATE)
     {
-        sBattleGroundMgr.BGFreeSlotQueue[m_TypeID].push_front(this);
+        sBattleGroundMgr.BGFreeSlotQueue[m_TypeID][m_BracketId].push_front(this);
         m_InBGFreeSlotQueue = true;
     }
 }
@@ -1331,9 +1331,12 @@ void BattleGround::AddToBGFreeSlotQueue()
 /* This method removes this battleground from free queue - it must be called when deleting battleground - not used now*/
 void BattleGround::RemoveFromBGFreeSlotQueue()
 {
+    if (!m_InBGFreeSlotQueue)
+        return;
+
     // set to be able to re-add if needed
     m_InBGFreeSlotQueue = false;
-    BGFreeSlotQueueType& bgFreeSlot = sBattleGroundMgr.BGFreeSlotQueue[m_TypeID];
+    BGFreeSlotQueueType& bgFreeSlot = sBattleGroundMgr.BGFreeSlotQueue[m_TypeID][m_BracketId];
     for (BGFreeSlotQueueType::iterator itr = bgFreeSlot.begin(); itr != bgFreeSlot.end(); ++itr)
     {
         if ((*itr)->GetInstanceID() == GetInstanceID())
@@ -141,6 +141,66 @@ bool BattleGroundQueue::SelectionPool::AddGroup(GroupQueueInfo* ginfo, uint32 de
 /***               BATTLEGROUND QUEUES                 ***/
 /*********************************************************/
 
+// add group to the end of a queue, rated arena teams are indexed by their rating too
+void BattleGroundQueue::AddGroupToQueue(GroupQueueInfo* ginfo, BattleGroundBracketId bracket_id, uint32 index)
+{
+    GroupsQueueType& queue = m_QueuedGroups[bracket_id][index];
+    ginfo->BracketId = bracket_id;
+    ginfo->QueueIndex = index;
+    ginfo->QueueItr = queue.insert(queue.end(), ginfo);
+
+    if (ginfo->IsRated && !ginfo->IsInvitedToBGInstanceGUID)
+        ginfo->RatingItr = m_RatedGroups[bracket_id][index].insert(GroupsRatingIndexType::value_type(ginfo->ArenaTeamRating, ginfo));
+}
+
+// move group to the front of another queue of its bracket, the list node is spliced so QueueItr stays valid
+void BattleGroundQueue::MoveGroupToQueue(GroupQueueInfo* ginfo, uint32 index)
+{
+    GroupsQueueType& queue = m_QueuedGroups[ginfo->BracketId][index];
+    queue.splice(queue.begin(), m_QueuedGroups[ginfo->BracketId][ginfo->QueueIndex], ginfo->QueueItr);
+
+    if (ginfo->IsRated && !ginfo->IsInvitedToBGInstanceGUID)
+    {
+        m_RatedGroups[ginfo->BracketId][ginfo->QueueIndex].erase(ginfo->RatingItr);
+        ginfo->RatingItr = m_RatedGroups[ginfo->BracketId][index].insert(GroupsRatingIndexType::value_type(ginfo->ArenaTeamRating, ginfo));
+    }
+
+    ginfo->QueueIndex = index;
+}
+
+void BattleGroundQueue::EraseGroupFromQueue(GroupQueueInfo* ginfo)
+{
+    if (ginfo->IsRated && !ginfo->IsInvitedToBGInstanceGUID)
+        m_RatedGroups[ginfo->BracketId][ginfo->QueueIndex].erase(ginfo->RatingItr);
+
+    m_QueuedGroups[ginfo->BracketId][ginfo->QueueIndex].erase(ginfo->QueueItr);
+}
+
+// returns the not invited rated team that joined first and has its rating in [minRating, maxRating] or joined before discardTime
+GroupQueueInfo* BattleGroundQueue::SelectRatedGroup(BattleGroundBracketId bracket_id, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* exclude) const
+{
+    // waiting teams are ordered by join time (only invited teams are moved to the front), so only the first one can have its rating discarded
+    GroupsQueueType const& queue = m_QueuedGroups[bracket_id][index];
+    for (GroupsQueueType::const_iterator itr = queue.begin(); itr != queue.end(); ++itr)
+    {
+        if ((*itr)->IsInvitedToBGInstanceGUID || *itr == exclude)
+            continue;
+
+        if ((*itr)->JoinTime < discardTime)
+            return *itr;
+        break;
+    }
+
+    // the rating window is usually a small part of the queue
+    GroupQueueInfo* selected = nullptr;
+    GroupsRatingIndexType const& ratedGroups = m_RatedGroups[bracket_id][index];
+    for (GroupsRatingIndexType::const_iterator itr = ratedGroups.lower_bound(minRating); itr != ratedGroups.end() && itr->first <= maxRating; ++itr)
+        if (itr->second != exclude && (!selected || itr->second->JoinTime < selected->JoinTime))
+            selected = itr->second;
+
+    return selected;
+}
+
 // add group or player (grp == nullptr) to bg queue with the given leader and bg specifications
 GroupQueueInfo* BattleGroundQueue::AddGroup(Player* leader, Group* grp, BattleGroundTypeId BgTypeId, BattleGroundBracketId bracketId, ArenaType arenaType, bool isRated, bool isPremade, uint32 arenaRating, uint32 arenateamid)
 {
@@ -203,7 +263,7 @@ GroupQueueInfo* BattleGroundQueue::AddGroup(Player* leader, Group* grp, BattleGr
         }
 
         // add GroupInfo to m_QueuedGroups
-        m_QueuedGroups[bracketId][index].push_back(ginfo);
+        AddGroupToQueue(ginfo, bracketId, index);
 
         // announce to world, this code needs mutex
         if (arenaType == ARENA_TYPE_NONE && !isRated && !isPremade && sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN))
@@ -298,7 +358,6 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // Player *plr = sObjectMgr.GetPlayer(guid);
     // std::lock_guard<std::recursive_mutex> guard(m_Lock);
 
-    int32 bracket_id = -1;                                  // signed for proper for-loop finish
     QueuedPlayersMap::iterator itr;
 
     // remove player from map, if he's there
@@ -309,39 +368,9 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
         return;
     }
 
+    // the group knows its queue, so there is no need to search the brackets for it
     GroupQueueInfo* group = itr->second.GroupInfo;
-    GroupsQueueType::iterator group_itr, group_itr_tmp;
-    // mostly people with the highest levels are in battlegrounds, thats why
-    // we count from MAX_BATTLEGROUND_QUEUES - 1 to 0
-    // variable index removes useless searching in other team's queue
-    uint32 index = BattleGround::GetTeamIndexByTeamId(group->GroupTeam);
-
-    for (int8 bracket_id_tmp = MAX_BATTLEGROUND_BRACKETS - 1; bracket_id_tmp >= 0 && bracket_id == -1; --bracket_id_tmp)
-    {
-        // we must check premade and normal team's queue - because when players from premade are joining bg,
-        // they leave groupinfo so we can't use its players size to find out index
-        for (uint8 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT; j += BG_QUEUE_NORMAL_ALLIANCE)
-        {
-            for (group_itr_tmp = m_QueuedGroups[bracket_id_tmp][j].begin(); group_itr_tmp != m_QueuedGroups[bracket_id_tmp][j].end(); ++group_itr_tmp)
-            {
-                if ((*group_itr_tmp) == group)
-                {
-                    bracket_id = bracket_id_tmp;
-                    group_itr = group_itr_tmp;
-                    // we must store index to be able to erase iterator
-                    index = j;
-                    break;
-                }
-            }
-        }
-    }
-    // player can't be in queue without group, but just in case
-    if (bracket_id == -1)
-    {
-        sLog.outError("BattleGroundQueue: ERROR Cannot find groupinfo for %s", guid.GetString().c_str());
-        return;
-    }
-    DEBUG_LOG("BattleGroundQueue: Removing %s, from bracket_id %u", guid.GetString().c_str(), (uint32)bracket_id);
+    DEBUG_LOG("BattleGroundQueue: Removing %s, from bracket_id %u", guid.GetString().c_str(), (uint32)group->BracketId);
 
     // ALL variables are correctly set
     // We can ignore leveling up in queue - it should not cause crash
@@ -387,7 +416,7 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // remove group queue info if needed
     if (group->Players.empty())
     {
-        m_QueuedGroups[bracket_id][index].erase(group_itr);
+        EraseGroupFromQueue(group);
         delete group;
     }
     // if group wasn't empty, so it wasn't deleted, and player have left a rated
@@ -441,7 +470,10 @@ bool BattleGroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, BattleGround* bg,
 
     if (!ginfo->IsInvitedToBGInstanceGUID)
     {
-        // not yet invited
+        // not yet invited, so it can't be matched against other arena teams anymore
+        if (ginfo->IsRated)
+            m_RatedGroups[ginfo->BracketId][ginfo->QueueIndex].erase(ginfo->RatingItr);
+
         // set invitation
         ginfo->IsInvitedToBGInstanceGUID = bg->GetInstanceID();
         BattleGroundTypeId bgTypeId = bg->GetTypeID();
@@ -627,8 +659,7 @@ bool BattleGroundQueue::CheckPremadeMatch(BattleGroundBracketId bracket_id, uint
             if (!(*itr)->IsInvitedToBGInstanceGUID && ((*itr)->JoinTime < time_before || (*itr)->Players.size() < MinPlayersPerTeam))
             {
                 // we must insert group to normal queue and erase pointer from premade queue
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
+                MoveGroupToQueue(*itr, BG_QUEUE_NORMAL_ALLIANCE + i);
             }
         }
     }
@@ -698,13 +729,9 @@ bool BattleGroundQueue::CheckSkirmishForSameFaction(BattleGroundBracketId bracke
     // store last ginfo pointer
     GroupQueueInfo* ginfo = m_SelectionPools[teamIdx].SelectedGroups.back();
     // set itr_team to group that was added to selection pool latest
-    GroupsQueueType::iterator itr_team = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].begin();
-    for (; itr_team != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].end(); ++itr_team)
-        if (ginfo == *itr_team)
-            break;
-    if (itr_team == m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].end())
+    if (ginfo->BracketId != bracket_id || ginfo->QueueIndex != uint32(BG_QUEUE_NORMAL_ALLIANCE + teamIdx))
         return false;
-    GroupsQueueType::iterator itr_team2 = itr_team;
+    GroupsQueueType::iterator itr_team2 = ginfo->QueueItr;
     ++itr_team2;
     // invite players to other selection pool
     for (; itr_team2 != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].end(); ++itr_team2)
@@ -721,19 +748,8 @@ bool BattleGroundQueue::CheckSkirmishForSameFaction(BattleGroundBracketId bracke
     {
         // set correct team
         (*itr)->GroupTeam = otherTeamId;
-        // add team to other queue
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + otherTeamIdx].push_front(*itr);
-        // remove team from old queue
-        GroupsQueueType::iterator itr2 = itr_team;
-        ++itr2;
-        for (; itr2 != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].end(); ++itr2)
-        {
-            if (*itr2 == *itr)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].erase(itr2);
-                break;
-            }
-        }
+        // move team to other queue
+        MoveGroupToQueue(*itr, BG_QUEUE_NORMAL_ALLIANCE + otherTeamIdx);
     }
     return true;
 }
@@ -754,15 +770,15 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
         return;
 
     // battleground with free slot for player should be always in the beggining of the queue
-    // maybe it would be better to create bgfreeslotqueue for each bracket_id
+    // the free slot queue is kept per bracket, so only battlegrounds of this bracket are visited
+    BGFreeSlotQueueType& freeSlotQueue = sBattleGroundMgr.BGFreeSlotQueue[bgTypeId][bracket_id];
     BGFreeSlotQueueType::iterator itr, next;
-    for (itr = sBattleGroundMgr.BGFreeSlotQueue[bgTypeId].begin(); itr != sBattleGroundMgr.BGFreeSlotQueue[bgTypeId].end(); itr = next)
+    for (itr = freeSlotQueue.begin(); itr != freeSlotQueue.end(); itr = next)
     {
         next = itr;
         ++next;
         // DO NOT allow queue manager to invite new player to arena
-        if ((*itr)->isBattleGround() && (*itr)->GetTypeID() == bgTypeId && (*itr)->GetBracketId() == bracket_id &&
-                (*itr)->GetStatus() > STATUS_WAIT_QUEUE && (*itr)->GetStatus() < STATUS_WAIT_LEAVE)
+        if ((*itr)->isBattleGround() && (*itr)->GetStatus() > STATUS_WAIT_QUEUE && (*itr)->GetStatus() < STATUS_WAIT_LEAVE)
         {
             BattleGround* bg = *itr; // we have to store battleground pointer here, because when battleground is full, it is removed from free queue (not yet implemented!!)
             // and iterator is invalid
@@ -920,62 +936,27 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
         uint32 discardTime = WorldTimer::getMSTime() - sBattleGroundMgr.GetRatingDiscardTimer();
 
         // we need to find 2 teams which will play next game
-
-        GroupsQueueType::iterator itr_team[PVP_TEAM_COUNT];
-
         // optimalization : --- we dont need to use selection_pools - each update we select max 2 groups
 
         for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; ++i)
         {
-            // take the group that joined first
-            itr_team[i] = m_QueuedGroups[bracket_id][i].begin();
-            for (; itr_team[i] != m_QueuedGroups[bracket_id][i].end(); ++(itr_team[i]))
-            {
-                // if group match conditions, then add it to pool
-                if (!(*itr_team[i])->IsInvitedToBGInstanceGUID
-                        && (((*itr_team[i])->ArenaTeamRating >= arenaMinRating && (*itr_team[i])->ArenaTeamRating <= arenaMaxRating)
-                            || (*itr_team[i])->JoinTime < discardTime))
-                {
-                    m_SelectionPools[i].AddGroup((*itr_team[i]), MaxPlayersPerTeam);
-                    // break for cycle to be able to start selecting another group from same faction queue
-                    break;
-                }
-            }
+            // take the group that joined first, if group match conditions, then add it to pool
+            if (GroupQueueInfo* ginfo = SelectRatedGroup(bracket_id, i, arenaMinRating, arenaMaxRating, discardTime, nullptr))
+                m_SelectionPools[i].AddGroup(ginfo, MaxPlayersPerTeam);
         }
         // now we are done if we have 2 groups - ali vs horde!
         // if we don't have, we must try to continue search in same queue
-        // tmp variables are correctly set
-        // this code isn't much userfriendly - but it is supposed to continue search for mathing group in HORDE queue
+        // this is supposed to continue search for mathing group in HORDE queue
         if (m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() == 0 && m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount())
         {
-            itr_team[TEAM_INDEX_ALLIANCE] = itr_team[TEAM_INDEX_HORDE];
-            ++itr_team[TEAM_INDEX_ALLIANCE];
-            for (; itr_team[TEAM_INDEX_ALLIANCE] != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].end(); ++(itr_team[TEAM_INDEX_ALLIANCE]))
-            {
-                if (!(*itr_team[TEAM_INDEX_ALLIANCE])->IsInvitedToBGInstanceGUID
-                        && (((*itr_team[TEAM_INDEX_ALLIANCE])->ArenaTeamRating >= arenaMinRating && (*itr_team[TEAM_INDEX_ALLIANCE])->ArenaTeamRating <= arenaMaxRating)
-                            || (*itr_team[TEAM_INDEX_ALLIANCE])->JoinTime < discardTime))
-                {
-                    m_SelectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*itr_team[TEAM_INDEX_ALLIANCE]), MaxPlayersPerTeam);
-                    break;
-                }
-            }
+            if (GroupQueueInfo* ginfo = SelectRatedGroup(bracket_id, BG_QUEUE_PREMADE_HORDE, arenaMinRating, arenaMaxRating, discardTime, m_SelectionPools[TEAM_INDEX_HORDE].SelectedGroups.front()))
+                m_SelectionPools[TEAM_INDEX_ALLIANCE].AddGroup(ginfo, MaxPlayersPerTeam);
         }
-        // this code isn't much userfriendly - but it is supposed to continue search for mathing group in ALLIANCE queue
+        // this is supposed to continue search for mathing group in ALLIANCE queue
         if (m_SelectionPools[TEAM_INDEX_HORDE].GetPlayerCount() == 0 && m_SelectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())
         {
-            itr_team[TEAM_INDEX_HORDE] = itr_team[TEAM_INDEX_ALLIANCE];
-            ++itr_team[TEAM_INDEX_HORDE];
-            for (; itr_team[TEAM_INDEX_HORDE] != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].end(); ++(itr_team[TEAM_INDEX_HORDE]))
-            {
-                if (!(*itr_team[TEAM_INDEX_HORDE])->IsInvitedToBGInstanceGUID
-                        && (((*itr_team[TEAM_INDEX_HORDE])->ArenaTeamRating >= arenaMinRating && (*itr_team[TEAM_INDEX_HORDE])->ArenaTeamRating <= arenaMaxRating)
-                            || (*itr_team[TEAM_INDEX_HORDE])->JoinTime < discardTime))
-                {
-                    m_SelectionPools[TEAM_INDEX_HORDE].AddGroup((*itr_team[TEAM_INDEX_HORDE]), MaxPlayersPerTeam);
-                    break;
-                }
-            }
+            if (GroupQueueInfo* ginfo = SelectRatedGroup(bracket_id, BG_QUEUE_PREMADE_ALLIANCE, arenaMinRating, arenaMaxRating, discardTime, m_SelectionPools[TEAM_INDEX_ALLIANCE].SelectedGroups.front()))
+                m_SelectionPools[TEAM_INDEX_HORDE].AddGroup(ginfo, MaxPlayersPerTeam);
         }
 
         // if we have 2 teams, then start new arena and invite players!
@@ -988,28 +969,21 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
                 return;
             }
 
-            (*(itr_team[TEAM_INDEX_ALLIANCE]))->OpponentsTeamRating = (*(itr_team[TEAM_INDEX_HORDE]))->ArenaTeamRating;
-            DEBUG_LOG("setting oposite teamrating for team %u to %u", (*(itr_team[TEAM_INDEX_ALLIANCE]))->ArenaTeamId, (*(itr_team[TEAM_INDEX_ALLIANCE]))->OpponentsTeamRating);
-            (*(itr_team[TEAM_INDEX_HORDE]))->OpponentsTeamRating = (*(itr_team[TEAM_INDEX_ALLIANCE]))->ArenaTeamRating;
-            DEBUG_LOG("setting oposite teamrating for team %u to %u", (*(itr_team[TEAM_INDEX_HORDE]))->ArenaTeamId, (*(itr_team[TEAM_INDEX_HORDE]))->OpponentsTeamRating);
+            GroupQueueInfo* aTeam = m_SelectionPools[TEAM_INDEX_ALLIANCE].SelectedGroups.front();
+            GroupQueueInfo* hTeam = m_SelectionPools[TEAM_INDEX_HORDE].SelectedGroups.front();
+
+            aTeam->OpponentsTeamRating = hTeam->ArenaTeamRating;
+            DEBUG_LOG("setting oposite teamrating for team %u to %u", aTeam->ArenaTeamId, aTeam->OpponentsTeamRating);
+            hTeam->OpponentsTeamRating = aTeam->ArenaTeamRating;
+            DEBUG_LOG("setting oposite teamrating for team %u to %u", hTeam->ArenaTeamId, hTeam->OpponentsTeamRating);
             // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
-            if ((*(itr_team[TEAM_INDEX_ALLIANCE]))->GroupTeam != ALLIANCE)
-            {
-                // add to alliance queue
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(*(itr_team[TEAM_INDEX_ALLIANCE]));
-                // erase from horde queue
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_team[TEAM_INDEX_ALLIANCE]);
-                itr_team[TEAM_INDEX_ALLIANCE] = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].begin();
-            }
-            if ((*(itr_team[TEAM_INDEX_HORDE]))->GroupTeam != HORDE)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(*(itr_team[TEAM_INDEX_HORDE]));
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_team[TEAM_INDEX_HORDE]);
-                itr_team[TEAM_INDEX_HORDE] = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].begin();
-            }
+            if (aTeam->GroupTeam != ALLIANCE)
+                MoveGroupToQueue(aTeam, BG_QUEUE_PREMADE_ALLIANCE);
+            if (hTeam->GroupTeam != HORDE)
+                MoveGroupToQueue(hTeam, BG_QUEUE_PREMADE_HORDE);
 
-            InviteGroupToBG(*(itr_team[TEAM_INDEX_ALLIANCE]), arena, ALLIANCE);
-            InviteGroupToBG(*(itr_team[TEAM_INDEX_HORDE]), arena, HORDE);
+            InviteGroupToBG(aTeam, arena, ALLIANCE);
+            InviteGroupToBG(hTeam, arena, HORDE);
 
             DEBUG_LOG("Starting rated arena match!");
 
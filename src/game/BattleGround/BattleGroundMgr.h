@@ -48,6 +48,11 @@ struct PlayerQueueInfo                                      // stores informatio
 
 typedef std::map<ObjectGuid, PlayerQueueInfo*> GroupQueueInfoPlayers;
 
+// we need constant add to begin and constant remove / add from the end, therefore deque suits our problem well
+typedef std::list<GroupQueueInfo*> GroupsQueueType;
+// rated arena teams waiting for an invitation, ordered by their rating
+typedef std::multimap<uint32, GroupQueueInfo*> GroupsRatingIndexType;
+
 struct GroupQueueInfo                                       // stores information about the group in queue (also used when joined as solo!)
 {
     GroupQueueInfoPlayers Players;                          // player queue info map
@@ -61,6 +66,10 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  IsInvitedToBGInstanceGUID;                      // was invited to certain BG
     uint32  ArenaTeamRating;                                // if rated match, inited to the rating of the team
     uint32  OpponentsTeamRating;                            // for rated arena matches
+    BattleGroundBracketId BracketId;                        // bracket of the queue the group is in
+    uint32  QueueIndex;                                     // BattleGroundQueueGroupTypes of the queue the group is in
+    GroupsQueueType::iterator QueueItr;                     // position in that queue, for fast removal
+    GroupsRatingIndexType::iterator RatingItr;              // position in the rating index, valid while rated and not invited
 };
 
 enum BattleGroundQueueGroupTypes
@@ -100,9 +109,6 @@ class BattleGroundQueue
         typedef std::map<ObjectGuid, PlayerQueueInfo> QueuedPlayersMap;
         QueuedPlayersMap m_QueuedPlayers;
 
-        // we need constant add to begin and constant remove / add from the end, therefore deque suits our problem well
-        typedef std::list<GroupQueueInfo*> GroupsQueueType;
-
         /*
         This two dimensional array is used to store All queued groups
         First dimension specifies the bgTypeId
@@ -114,6 +120,14 @@ class BattleGroundQueue
         */
         GroupsQueueType m_QueuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
 
+        // rated arena teams of the premade queues that are not invited yet, so matching does not walk the whole queue
+        GroupsRatingIndexType m_RatedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
+
+        void AddGroupToQueue(GroupQueueInfo* ginfo, BattleGroundBracketId bracket_id, uint32 index);
+        void MoveGroupToQueue(GroupQueueInfo* ginfo, uint32 index);
+        void EraseGroupFromQueue(GroupQueueInfo* ginfo);
+        GroupQueueInfo* SelectRatedGroup(BattleGroundBracketId bracket_id, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* exclude) const;
+
         // class to select and invite groups to bg
         class SelectionPool
         {
@@ -228,7 +242,7 @@ class BattleGroundMgr
         // these queues are instantiated when creating BattlegroundMrg
         BattleGroundQueue m_BattleGroundQueues[MAX_BATTLEGROUND_QUEUE_TYPES]; // public, because we need to access them in BG handler code
 
-        BGFreeSlotQueueType BGFreeSlotQueue[MAX_BATTLEGROUND_TYPE_ID];
+        BGFreeSlotQueueType BGFreeSlotQueue[MAX_BATTLEGROUND_TYPE_ID][MAX_BATTLEGROUND_BRACKETS];
 
         void ScheduleQueueUpdate(uint32 arenaRating, ArenaType arenaType, BattleGroundQueueTypeId bgQueueTypeId, BattleGroundTypeId bgTypeId, BattleGroundBracketId bracket_id);
         uint32 GetMaxRatingDifference() const;
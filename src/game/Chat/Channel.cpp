@@ -102,9 +102,7 @@ void Channel::Join(Player* player, const char* password)
 
     data.clear();
 
-    PlayerInfo& pinfo = m_players[guid];
-    pinfo.player = guid;
-    pinfo.flags = MEMBER_FLAG_NONE;
+    AddMember(player);
 
     MakeYouJoined(data);
     SendToOne(data, guid);
@@ -146,7 +144,7 @@ void Channel::Leave(Player* player, bool send)
 
     bool changeowner = m_players[guid].IsOwner();
 
-    m_players.erase(guid);
+    RemoveMember(guid);
     if (m_announce && (player->GetSession()->GetSecurity() < SEC_GAMEMASTER || !sWorld.getConfig(CONFIG_BOOL_SILENTLY_GM_JOIN_TO_CHANNEL)))
     {
         WorldPacket data;
@@ -223,7 +221,7 @@ void Channel::KickOrBan(Player* player, const char* targetName, bool ban)
         MakePlayerKicked(data, targetGuid, guid);
 
     SendToAll(data);
-    m_players.erase(targetGuid);
+    RemoveMember(targetGuid);
     target->LeftChannel(this);
 
     if (changeowner)
@@ -467,17 +465,17 @@ void Channel::List(Player* player)
     AccountTypes gmLevelInWhoList = (AccountTypes)sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_IN_WHO_LIST);
 
     uint32 count  = 0;
-    for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
+    for (MemberList::const_iterator i = m_members.begin(); i != m_members.end(); ++i)
     {
-        Player* plr = sObjectMgr.GetPlayer(i->first);
+        Player* plr = *i;
 
         // PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
         // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
-        if (plr && (player->GetSession()->GetSecurity() > SEC_PLAYER || plr->GetSession()->GetSecurity() <= gmLevelInWhoList) &&
+        if ((player->GetSession()->GetSecurity() > SEC_PLAYER || plr->GetSession()->GetSecurity() <= gmLevelInWhoList) &&
                 plr->IsVisibleGloballyFor(player))
         {
-            data << ObjectGuid(i->first);
-            data << uint8(i->second.flags);                 // flags seems to be changed...
+            data << plr->GetObjectGuid();
+            data << uint8(GetPlayerFlags(plr->GetObjectGuid())); // flags seems to be changed...
             ++count;
         }
     }
@@ -680,10 +678,10 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket const& data, ObjectGuid guid) const
 {
-    for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
-        if (Player* plr = sObjectMgr.GetPlayer(i->first))
-            if (!guid || !plr->GetSocial()->HasIgnore(guid))
-                plr->GetSession()->SendPacket(data);
+    // same packet for all members, no player lookups needed
+    for (MemberList::const_iterator i = m_members.begin(); i != m_members.end(); ++i)
+        if (!guid || !(*i)->GetSocial()->HasIgnore(guid))
+            (*i)->GetSession()->SendPacket(data);
 }
 
 void Channel::SendToOne(WorldPacket const& data, ObjectGuid who) const
@@ -692,6 +690,34 @@ void Channel::SendToOne(WorldPacket const& data, ObjectGuid who) const
         plr->GetSession()->SendPacket(data);
 }
 
+void Channel::AddMember(Player* player)
+{
+    PlayerInfo& pinfo = m_players[player->GetObjectGuid()];
+    pinfo.player = player->GetObjectGuid();
+    pinfo.flags = MEMBER_FLAG_NONE;
+    pinfo.memberIndex = m_members.size();
+
+    m_members.push_back(player);
+}
+
+void Channel::RemoveMember(ObjectGuid guid)
+{
+    PlayerList::iterator p_itr = m_players.find(guid);
+    if (p_itr == m_players.end())
+        return;
+
+    uint32 index = p_itr->second.memberIndex;
+    m_players.erase(p_itr);
+
+    // move the last member into the free slot
+    Player* last = m_members.back();
+    m_members[index] = last;
+    m_members.pop_back();
+
+    if (index < m_members.size())
+        m_players[last->GetObjectGuid()].memberIndex = index;
+}
+
 void Channel::Voice(ObjectGuid /*guid1*/, ObjectGuid /*guid2*/) const
 {
 }
@@ -120,6 +120,7 @@ class Channel
         {
             ObjectGuid player;
             uint8 flags;
+            uint32 memberIndex;                             // position in m_members
 
             bool HasFlag(uint8 flag) const { return !!(flags & flag); }
             void SetFlag(uint8 flag) { if (!HasFlag(flag)) flags |= flag; }
@@ -226,6 +227,9 @@ class Channel
         void SendToAll(WorldPacket const& data, ObjectGuid guid = ObjectGuid()) const;
         void SendToOne(WorldPacket const& data, ObjectGuid who) const;
 
+        void AddMember(Player* player);
+        void RemoveMember(ObjectGuid guid);
+
         bool IsOn(ObjectGuid who) const { return m_players.find(who) != m_players.end(); }
         bool IsBanned(ObjectGuid guid) const { return m_banned.find(guid) != m_banned.end(); }
 
@@ -275,6 +279,10 @@ class Channel
 
         typedef     std::map<ObjectGuid, PlayerInfo> PlayerList;
         PlayerList  m_players;
+
+        // members in contiguous memory for sending, players always leave their channels before they are deleted
+        typedef     std::vector<Player*> MemberList;
+        MemberList  m_members;
         GuidSet m_banned;
 };
 #endif
@@ -31,6 +31,9 @@
 #include "Globals/ObjectMgr.h"
 #include "Entities/ObjectGuid.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
+#include "Server/OpcodeStats.h"
+#include "World/TickProfiler.h"
+#include "Maps/Map.h"
 
 bool ChatHandler::HandleDebugSendSpellFailCommand(char* args)
 {
@@ -1040,6 +1043,51 @@ bool ChatHandler::HandleDebugModValueCommand(char* args)
     return HandlerDebugModValueHelper(target, field, typeStr, valStr);
 }
 
+bool ChatHandler::HandleDebugOpcodeStatsCommand(char* args)
+{
+    if (ExtractLiteralArg(&args, "reset"))
+    {
+        sOpcodeStats.Reset();
+        SendSysMessage("Opcode stats reset.");
+        return true;
+    }
+
+    if (ExtractLiteralArg(&args, "dump"))
+    {
+        if (!sOpcodeStats.Dump())
+        {
+            PSendSysMessage("Opcode stats can't be written to '%s'.", sOpcodeStats.GetDumpFile().c_str());
+            SetSentErrorMessage(true);
+            return false;
+        }
+
+        PSendSysMessage("Opcode stats written to '%s'.", sOpcodeStats.GetDumpFile().c_str());
+        return true;
+    }
+
+    uint32 limit;
+    if (!ExtractOptUInt32(&args, limit, 10))
+        return false;
+
+    if (!sOpcodeStats.IsEnabled())
+        SendSysMessage("Opcode stats collection is disabled (OpcodeStats.Enable), showing old data only.");
+
+    uint64 seconds = uint64(std::chrono::duration_cast<std::chrono::seconds>(OpcodeStatsMgr::Clock::now() - sOpcodeStats.GetStartTime()).count());
+    PSendSysMessage("Top opcodes by handler time over the last " UI64FMTD " seconds:", seconds);
+
+    std::vector<uint16> opcodes;
+    sOpcodeStats.GetTopOpcodes(opcodes, limit);
+    for (uint16 opcode : opcodes)
+    {
+        OpcodeStatsMgr::OpcodeStat const& stat = sOpcodeStats.GetStat(opcode);
+        PSendSysMessage("%s (0x%.4X): calls " UI64FMTD ", total %.1f ms, avg " UI64FMTD " us, p50 < " UI64FMTD " us, p99 < " UI64FMTD " us, max " UI64FMTD " us",
+                        LookupOpcodeName(opcode), uint32(opcode), stat.count, stat.totalTime / 1000.0, stat.totalTime / stat.count,
+                        OpcodeStatsMgr::GetPercentile(stat, 50.0f), OpcodeStatsMgr::GetPercentile(stat, 99.0f), stat.maxTime);
+    }
+
+    return true;
+}
+
 bool ChatHandler::HandleDebugSpellCoefsCommand(char* args)
 {
     uint32 spellid = ExtractSpellIdFromLink(&args);
@@ -1152,6 +1200,67 @@ bool ChatHandler::HandleDebugTaxiCommand(char* /*args*/)
     return true;
 }
 
+bool ChatHandler::HandleDebugTickProfileCommand(char* args)
+{
+    if (ExtractLiteralArg(&args, "dump"))
+    {
+        if (!sTickProfiler.Dump())
+        {
+            PSendSysMessage("Tick profile can't be written to '%s'.", sTickProfiler.GetDumpFile().c_str());
+            SetSentErrorMessage(true);
+            return false;
+        }
+
+        PSendSysMessage("Tick profile written to '%s'.", sTickProfiler.GetDumpFile().c_str());
+        return true;
+    }
+
+    uint32 limit;
+    if (!ExtractOptUInt32(&args, limit, 5))
+        return false;
+
+    if (!sTickProfiler.IsEnabled())
+        SendSysMessage("Tick profiler is disabled (TickProfiler.Enable), showing old data only.");
+
+    uint32 p50, p99, max;
+    TickTimings& worldTimings = sTickProfiler.GetWorldTimings();
+    PSendSysMessage("World update over the last %u ticks (p50/p99/max in us):", worldTimings.GetSampleCount());
+    for (uint32 i = 0; i <= WORLD_PHASE_COUNT; ++i)
+    {
+        worldTimings.GetPhaseStats(i, p50, p99, max);
+        PSendSysMessage("  %s: %u / %u / %u", TickProfiler::GetWorldPhaseName(i), p50, p99, max);
+    }
+
+    std::vector<Map*> maps;
+    sTickProfiler.GetSlowestMaps(maps, limit);
+    for (Map* map : maps)
+    {
+        TickTimings const& timings = map->GetTickTimings();
+        timings.GetPhaseStats(MAP_PHASE_COUNT, p50, p99, max);
+        bool slow = sTickProfiler.GetMapBudget() && p99 > sTickProfiler.GetMapBudget() * IN_MILLISECONDS;
+        PSendSysMessage("Map %u (%s) instance %u%s: %u / %u / %u", map->GetId(), map->GetMapName(), map->GetInstanceId(),
+                        slow ? " [over budget]" : "", p50, p99, max);
+
+        std::string phases;
+        for (uint32 i = 0; i < MAP_PHASE_COUNT; ++i)
+        {
+            uint32 phaseP50, phaseP99, phaseMax;
+            timings.GetPhaseStats(i, phaseP50, phaseP99, phaseMax);
+            if (!phaseP99)
+                continue;
+
+            char buf[64];
+            snprintf(buf, sizeof(buf), " %s %u", TickProfiler::GetMapPhaseName(i), phaseP99);
+            phases += buf;
+        }
+
+        if (!phases.empty())
+            PSendSysMessage("  p99 per phase:%s", phases.c_str());
+    }
+
+    return true;
+}
+
 bool ChatHandler::HandleDebugWaypoint(char* args)
 {
     Creature* target = getSelectedCreature();
@@ -218,6 +218,33 @@ void ThreatContainer::clearReferences()
         delete (*i);
     }
     iThreatList.clear();
+    iReferences.clear();
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* pHostileReference)
+{
+    // appended unsorted, a reference coming back online can carry more threat than the last one
+    if (!iThreatList.empty() && iThreatList.back()->getThreat() < pHostileReference->getThreat())
+        iDirty = true;
+
+    iThreatList.push_back(pHostileReference);
+    pHostileReference->iThreatListPos = --iThreatList.end();
+    iReferences[pHostileReference->getUnitGuid()] = pHostileReference;
+}
+
+//============================================================
+// the reference knows its list position, no need to search it
+
+void ThreatContainer::remove(HostileReference* pRef)
+{
+    HostileReferenceMap::iterator itr = iReferences.find(pRef->getUnitGuid());
+    if (itr == iReferences.end() || itr->second != pRef)
+        return;
+
+    iReferences.erase(itr);
+    iThreatList.erase(pRef->iThreatListPos);
 }
 
 //============================================================
@@ -226,18 +253,9 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* pVictim)
 {
     if (!pVictim)
         return nullptr;
-    HostileReference* result = nullptr;
-    ObjectGuid guid = pVictim->GetObjectGuid();
-    for (ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        if ((*i)->getUnitGuid() == guid)
-        {
-            result = (*i);
-            break;
-        }
-    }
 
-    return result;
+    HostileReferenceMap::const_iterator itr = iReferences.find(pVictim->GetObjectGuid());
+    return itr != iReferences.end() ? itr->second : nullptr;
 }
 
 //============================================================
@@ -269,20 +287,61 @@ void ThreatContainer::modifyThreatPercent(Unit* pVictim, int32 pPercent)
 
 //============================================================
 
-bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
+bool HostileReferenceSortPredicate(std::pair<float, HostileReference*> const& lhs, std::pair<float, HostileReference*> const& rhs)
 {
-    // std::list::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
-    return lhs->getThreat() > rhs->getThreat();             // reverse sorting
+    return lhs.first > rhs.first;                           // reverse sorting
+}
+
+//============================================================
+// the list is sorted while it is not dirty (every threat change and every added reference is
+// checked), so a changed threat can only break the order against the direct neighbours.
+// changes that keep the order do not trigger a sort at all and everything else is collected
+// until the next update() sorts the list once
+
+void ThreatContainer::threatChanged(HostileReference* pRef, float pMod)
+{
+    if (iDirty || iThreatList.size() < 2)
+        return;
+
+    HostileReferenceMap::const_iterator found = iReferences.find(pRef->getUnitGuid());
+    if (found == iReferences.end() || found->second != pRef)
+        return;
+
+    ThreatList::iterator pos = pRef->iThreatListPos;
+    if (pMod > 0.0f)
+    {
+        if (pos != iThreatList.begin())
+        {
+            --pos;
+            if ((*pos)->getThreat() < pRef->getThreat())
+                iDirty = true;
+        }
+    }
+    else if (++pos != iThreatList.end() && (*pos)->getThreat() > pRef->getThreat())
+        iDirty = true;
 }
 
 //============================================================
 // Check if the list is dirty and sort if necessary
+// threat changes since the last update are applied in one go, sorting works on a contiguous copy
+// of the threat values and the list nodes are only relinked if the order really changed
 
 void ThreatContainer::update()
 {
     if (iDirty && iThreatList.size() > 1)
     {
-        iThreatList.sort(HostileReferenceSortPredicate);
+        iSortBuffer.clear();
+        for (ThreatList::const_iterator itr = iThreatList.begin(); itr != iThreatList.end(); ++itr)
+            iSortBuffer.push_back(std::make_pair((*itr)->getThreat(), *itr));
+
+        if (!std::is_sorted(iSortBuffer.begin(), iSortBuffer.end(), HostileReferenceSortPredicate))
+        {
+            std::stable_sort(iSortBuffer.begin(), iSortBuffer.end(), HostileReferenceSortPredicate);
+
+            // splice keeps iterators of the references valid
+            for (ThreatSortBuffer::const_iterator itr = iSortBuffer.begin(); itr != iSortBuffer.end(); ++itr)
+                iThreatList.splice(iThreatList.end(), iThreatList, itr->second->iThreatListPos);
+        }
     }
     iDirty = false;
 }
@@ -565,9 +624,11 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if ((getCurrentVictim() == hostileReference && threatRefStatusChangeEvent->getFValue() < 0.0f) ||
-                    (getCurrentVictim() != hostileReference && threatRefStatusChangeEvent->getFValue() > 0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            // a dropping victim has to be compared with every other target against the 110%/130% rules
+            if (getCurrentVictim() == hostileReference && threatRefStatusChangeEvent->getFValue() < 0.0f)
+                setDirty(true);
+            else                                            // keep the order exact for the neighbour check
+                iThreatContainer.threatChanged(hostileReference, threatRefStatusChangeEvent->getFValue());
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if (!hostileReference->isOnline())
@@ -584,8 +645,8 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
             {
                 if (getCurrentVictim() && hostileReference->getThreat() > (1.1f * getCurrentVictim()->getThreat()))
                     setDirty(true);
-                iThreatContainer.addReference(hostileReference);
                 iThreatOfflineContainer.remove(hostileReference);
+                iThreatContainer.addReference(hostileReference);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
@@ -25,14 +25,21 @@
 #include "Entities/UnitEvents.h"
 #include "Entities/ObjectGuid.h"
 #include <list>
+#include <vector>
+#include <unordered_map>
 
 //==============================================================
 
 class Unit;
 class Creature;
 class ThreatManager;
+class ThreatContainer;
+class HostileReference;
 struct SpellEntry;
 
+// list kept for stable iterators, threat can be added while the list is walked
+typedef std::list<HostileReference*> ThreatList;
+
 //==============================================================
 // Class to calculate the real threat based
 
@@ -121,32 +128,38 @@ class HostileReference : public Reference<Unit, ThreatManager>
 
         Unit* getSourceUnit() const;
     private:
+        friend class ThreatContainer;
+
         float iThreat;
         float iTempThreatModifyer;                          // used for taunt
         ObjectGuid iUnitGuid;
         bool iOnline;
         bool iAccessible;
+        ThreatList::iterator iThreatListPos;                // position in the container currently holding the reference
 };
 
 //==============================================================
-class ThreatManager;
-
-typedef std::list<HostileReference*> ThreatList;
-
 
 class ThreatContainer
 {
     private:
+        typedef std::unordered_map<ObjectGuid, HostileReference*> HostileReferenceMap;
+        typedef std::vector<std::pair<float, HostileReference*> > ThreatSortBuffer;
+
         ThreatList iThreatList;
+        HostileReferenceMap iReferences;                    // fast lookup by target guid
+        ThreatSortBuffer iSortBuffer;                       // threat values copied in contiguous memory for sorting
         bool iDirty;
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* pRef) { iThreatList.remove(pRef); }
-        void addReference(HostileReference* pHostileReference) { iThreatList.push_back(pHostileReference); }
+        void remove(HostileReference* pRef);
+        void addReference(HostileReference* pHostileReference);
         void clearReferences();
         // Sort the list if necessary
         void update();
+        // Mark the list dirty only if the changed reference passed one of its neighbours
+        void threatChanged(HostileReference* pRef, float pMod);
     public:
         ThreatContainer() { iDirty = false; }
         ~ThreatContainer() { clearReferences(); }
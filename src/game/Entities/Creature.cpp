@@ -2617,50 +2617,42 @@ void Creature::FillGuidsListFromThreatList(GuidVector& guids, uint32 maxamount /
 
 struct AddCreatureToRemoveListInMapsWorker
 {
-    AddCreatureToRemoveListInMapsWorker(ObjectGuid guid) : i_guid(guid) {}
+    AddCreatureToRemoveListInMapsWorker(uint32 guid, CreatureData const* data)
+        : i_guid(guid), i_data(data) {}
 
     void operator()(Map* map)
     {
-        if (Creature* pCreature = map->GetCreature(i_guid))
-            pCreature->AddObjectToRemoveList();
+        Creature::AddToRemoveListInMap(map, i_guid, i_data);
     }
 
-    ObjectGuid i_guid;
+    uint32 i_guid;
+    CreatureData const* i_data;
 };
 
 void Creature::AddToRemoveListInMaps(uint32 db_guid, CreatureData const* data)
 {
-    AddCreatureToRemoveListInMapsWorker worker(data->GetObjectGuid(db_guid));
+    AddCreatureToRemoveListInMapsWorker worker(db_guid, data);
     sMapMgr.DoForAllMapsWithMapId(data->mapid, worker);
 }
 
-struct SpawnCreatureInMapsWorker
+void Creature::AddToRemoveListInMap(Map* map, uint32 db_guid, CreatureData const* data)
 {
-    SpawnCreatureInMapsWorker(uint32 guid, CreatureData const* data)
-        : i_guid(guid), i_data(data) {}
+    if (Creature* pCreature = map->GetCreature(data->GetObjectGuid(db_guid)))
+        pCreature->AddObjectToRemoveList();
+}
 
-    void operator()(Map* map)
+void Creature::SpawnInMap(Map* map, uint32 db_guid, CreatureData const* data)
+{
+    // We use spawn coords to spawn, skip creatures already spawned in this map
+    if (map->IsLoaded(data->posX, data->posY) && !map->GetCreature(data->GetObjectGuid(db_guid)))
     {
-        // We use spawn coords to spawn
-        if (map->IsLoaded(i_data->posX, i_data->posY))
+        Creature* pCreature = new Creature;
+        // DEBUG_LOG("Spawning creature %u",*itr);
+        if (!pCreature->LoadFromDB(db_guid, map))
         {
-            Creature* pCreature = new Creature;
-            // DEBUG_LOG("Spawning creature %u",*itr);
-            if (!pCreature->LoadFromDB(i_guid, map))
-            {
-                delete pCreature;
-            }
+            delete pCreature;
         }
     }
-
-    uint32 i_guid;
-    CreatureData const* i_data;
-};
-
-void Creature::SpawnInMaps(uint32 db_guid, CreatureData const* data)
-{
-    SpawnCreatureInMapsWorker worker(db_guid, data);
-    sMapMgr.DoForAllMapsWithMapId(data->mapid, worker);
 }
 
 bool Creature::HasStaticDBSpawnData() const
@@ -550,6 +550,7 @@ struct SelectAttackingTargetParams
 class Creature : public Unit
 {
     public:
+        DECLARE_SLAB_ALLOCATED(GetCreatureAllocator)
 
         explicit Creature(CreatureSubtype subtype = CREATURE_SUBTYPE_GENERIC);
         virtual ~Creature();
@@ -757,9 +758,10 @@ class Creature : public Unit
         float GetRespawnRadius() const { return m_respawnradius; }
         void SetRespawnRadius(float dist) { m_respawnradius = dist; }
 
-        // Functions spawn/remove creature with DB guid in all loaded map copies (if point grid loaded in map)
+        // Functions spawn/remove creature with DB guid in all loaded map copies or in one map (if point grid loaded in map)
         static void AddToRemoveListInMaps(uint32 db_guid, CreatureData const* data);
-        static void SpawnInMaps(uint32 db_guid, CreatureData const* data);
+        static void AddToRemoveListInMap(Map* map, uint32 db_guid, CreatureData const* data);
+        static void SpawnInMap(Map* map, uint32 db_guid, CreatureData const* data);
 
         void SendZoneUnderAttackMessage(Player* attacker) const;
 
@@ -35,6 +35,7 @@ struct SpellEntry;
 class DynamicObject : public WorldObject
 {
     public:
+        DECLARE_SLAB_ALLOCATED(GetDynamicObjectAllocator)
         explicit DynamicObject();
 
         void AddToWorld() override;
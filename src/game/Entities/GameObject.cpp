@@ -1978,56 +1978,28 @@ void GameObject::AddToSkillupList(Player* player)
     m_SkillupSet.insert(player->GetObjectGuid());
 }
 
-struct AddGameObjectToRemoveListInMapsWorker
+void GameObject::AddToRemoveListInMap(Map* map, uint32 db_guid, GameObjectData const* data)
 {
-    AddGameObjectToRemoveListInMapsWorker(ObjectGuid guid) : i_guid(guid) {}
-
-    void operator()(Map* map)
-    {
-        if (GameObject* pGameobject = map->GetGameObject(i_guid))
-            pGameobject->AddObjectToRemoveList();
-    }
-
-    ObjectGuid i_guid;
-};
-
-void GameObject::AddToRemoveListInMaps(uint32 db_guid, GameObjectData const* data)
-{
-    AddGameObjectToRemoveListInMapsWorker worker(ObjectGuid(HIGHGUID_GAMEOBJECT, data->id, db_guid));
-    sMapMgr.DoForAllMapsWithMapId(data->mapid, worker);
+    if (GameObject* pGameobject = map->GetGameObject(ObjectGuid(HIGHGUID_GAMEOBJECT, data->id, db_guid)))
+        pGameobject->AddObjectToRemoveList();
 }
 
-struct SpawnGameObjectInMapsWorker
+void GameObject::SpawnInMap(Map* map, uint32 db_guid, GameObjectData const* data)
 {
-    SpawnGameObjectInMapsWorker(uint32 guid, GameObjectData const* data)
-        : i_guid(guid), i_data(data) {}
-
-    void operator()(Map* map)
+    // Spawn if necessary (loaded grids only), skip gameobjects already spawned in this map
+    if (map->IsLoaded(data->posX, data->posY) && !map->GetGameObject(ObjectGuid(HIGHGUID_GAMEOBJECT, data->id, db_guid)))
     {
-        // Spawn if necessary (loaded grids only)
-        if (map->IsLoaded(i_data->posX, i_data->posY))
+        GameObject* pGameobject = new GameObject;
+        // DEBUG_LOG("Spawning gameobject %u", *itr);
+        if (!pGameobject->LoadFromDB(db_guid, map))
         {
-            GameObject* pGameobject = new GameObject;
-            // DEBUG_LOG("Spawning gameobject %u", *itr);
-            if (!pGameobject->LoadFromDB(i_guid, map))
-            {
-                delete pGameobject;
-            }
-            else
-            {
-                map->Add(pGameobject);
-            }
+            delete pGameobject;
+        }
+        else
+        {
+            map->Add(pGameobject);
         }
     }
-
-    uint32 i_guid;
-    GameObjectData const* i_data;
-};
-
-void GameObject::SpawnInMaps(uint32 db_guid, GameObjectData const* data)
-{
-    SpawnGameObjectInMapsWorker worker(db_guid, data);
-    sMapMgr.DoForAllMapsWithMapId(data->mapid, worker);
 }
 
 bool GameObject::HasStaticDBSpawnData() const
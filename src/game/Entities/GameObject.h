@@ -594,6 +594,7 @@ struct GameObjectDisplayInfoEntry;
 class GameObject : public WorldObject
 {
     public:
+        DECLARE_SLAB_ALLOCATED(GetGameObjectAllocator)
         explicit GameObject();
         ~GameObject();
 
@@ -658,9 +659,9 @@ class GameObject : public WorldObject
         void Refresh();
         void Delete();
 
-        // Functions spawn/remove gameobject with DB guid in all loaded map copies (if point grid loaded in map)
-        static void AddToRemoveListInMaps(uint32 db_guid, GameObjectData const* data);
-        static void SpawnInMaps(uint32 db_guid, GameObjectData const* data);
+        // Functions spawn/remove gameobject with DB guid in the map (if point grid loaded in map)
+        static void AddToRemoveListInMap(Map* map, uint32 db_guid, GameObjectData const* data);
+        static void SpawnInMap(Map* map, uint32 db_guid, GameObjectData const* data);
 
         GameobjectTypes GetGoType() const { return GameobjectTypes(GetUInt32Value(GAMEOBJECT_TYPE_ID)); }
         void SetGoType(GameobjectTypes type) { SetUInt32Value(GAMEOBJECT_TYPE_ID, type); }
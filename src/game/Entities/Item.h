@@ -261,6 +261,7 @@ bool ItemCanGoIntoBag(ItemPrototype const* proto, ItemPrototype const* pBagProto
 class Item : public Object
 {
     public:
+        DECLARE_SLAB_ALLOCATED(GetItemAllocator)
         static Item* CreateItem(uint32 item, uint32 count, Player const* player = nullptr, uint32 randomPropertyId = 0);
         Item* CloneItem(uint32 count, Player const* player = nullptr) const;
 
@@ -39,6 +39,7 @@
 #include "OutdoorPvP/OutdoorPvP.h"
 #include "Entities/Pet.h"
 #include "Social/SocialMgr.h"
+#include "World/WhoListCache.h"
 
 void WorldSession::HandleRepopRequestOpcode(WorldPacket& recv_data)
 {
@@ -142,92 +143,44 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recv_data)
     data << uint32(matchcount);                             // placeholder, count of players matching criteria
     data << uint32(displaycount);                           // placeholder, count of players displayed
 
-    // TODO: Guard Player map
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
-    {
-        Player* pl = itr->second;
+    // without refresh interval the snapshot is rebuilt for every request
+    if (!sWorld.getConfig(CONFIG_UINT32_WHO_LIST_REFRESH_INTERVAL))
+        sWhoListCache.Refresh();
+
+    WhoListCache::PlayerInfoList players;
+    sWhoListCache.GetPlayers(level_min, level_max, classmask, racemask, zoneids, zones_count, players);
 
+    for (WhoListPlayerInfo const* info : players)
+    {
         if (security == SEC_PLAYER)
         {
             // player can see member of other team only if CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST
-            if (pl->GetTeam() != team && !allowTwoSideWhoList)
+            if (info->team != team && !allowTwoSideWhoList)
                 continue;
 
             // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
-            if (pl->GetSession()->GetSecurity() > gmLevelInWhoList)
+            if (info->security > gmLevelInWhoList)
                 continue;
         }
 
-        // do not process players which are not in world
-        if (!pl->IsInWorld())
-            continue;
-
-        // check if target is globally visible for player
-        if (!pl->IsVisibleGloballyFor(_player))
-            continue;
-
-        // check if target's level is in level range
-        uint32 lvl = pl->getLevel();
-        if (lvl < level_min || lvl > level_max)
-            continue;
-
-        // check if class matches classmask
-        uint32 class_ = pl->getClass();
-        if (!(classmask & (1 << class_)))
-            continue;
-
-        // check if race matches racemask
-        uint32 race = pl->getRace();
-        if (!(racemask & (1 << race)))
-            continue;
-
-        uint32 pzoneid = pl->GetZoneId();
-        uint8 gender = pl->getGender();
-
-        bool z_show = true;
-        for (uint32 i = 0; i < zones_count; ++i)
-        {
-            if (zoneids[i] == pzoneid)
-            {
-                z_show = true;
-                break;
-            }
-
-            z_show = false;
-        }
-        if (!z_show)
-            continue;
-
-        std::string pname = pl->GetName();
-        std::wstring wpname;
-        if (!Utf8toWStr(pname, wpname))
-            continue;
-        wstrToLower(wpname);
-
-        if (!(wplayer_name.empty() || wpname.find(wplayer_name) != std::wstring::npos))
+        if (!(wplayer_name.empty() || info->wname.find(wplayer_name) != std::wstring::npos))
             continue;
 
-        std::string gname = sGuildMgr.GetGuildNameById(pl->GetGuildId());
-        std::wstring wgname;
-        if (!Utf8toWStr(gname, wgname))
-            continue;
-        wstrToLower(wgname);
-
-        if (!(wguild_name.empty() || wgname.find(wguild_name) != std::wstring::npos))
+        if (!(wguild_name.empty() || info->wguildName.find(wguild_name) != std::wstring::npos))
             continue;
 
         std::string aname;
-        if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(pzoneid))
-            aname = areaEntry->area_name[GetSessionDbcLocale()];
+        if (str_count)
+            if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(info->zoneId))
+                aname = areaEntry->area_name[GetSessionDbcLocale()];
 
         bool s_show = true;
         for (uint32 i = 0; i < str_count; ++i)
         {
             if (!str[i].empty())
             {
-                if (wgname.find(str[i]) != std::wstring::npos ||
-                        wpname.find(str[i]) != std::wstring::npos ||
+                if (info->wguildName.find(str[i]) != std::wstring::npos ||
+                        info->wname.find(str[i]) != std::wstring::npos ||
                         Utf8FitTo(aname, str[i]))
                 {
                     s_show = true;
@@ -239,19 +192,24 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recv_data)
         if (!s_show)
             continue;
 
+        // do not process players which logged out since the snapshot, and check if target is globally visible for player
+        Player* pl = ObjectAccessor::FindPlayer(info->guid);
+        if (!pl || !pl->IsVisibleGloballyFor(_player))
+            continue;
+
         // 49 is maximum player count sent to client
         if (++matchcount > 49)
             continue;
 
         ++displaycount;
 
-        data << pname;                                      // player name
-        data << gname;                                      // guild name
-        data << uint32(lvl);                                // player level
-        data << uint32(class_);                             // player class
-        data << uint32(race);                               // player race
-        data << uint8(gender);                              // player gender
-        data << uint32(pzoneid);                            // player zone id
+        data << info->name;                                 // player name
+        data << info->guildName;                            // guild name
+        data << uint32(info->level);                        // player level
+        data << uint32(info->class_);                       // player class
+        data << uint32(info->race);                         // player race
+        data << uint8(info->gender);                        // player gender
+        data << uint32(info->zoneId);                       // player zone id
     }
 
     if (sWorld.getConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS) && matchcount > sWorld.getConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS))
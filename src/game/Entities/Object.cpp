@@ -30,6 +30,7 @@
 #include "UpdateMask.h"
 #include "Util.h"
 #include "Maps/MapManager.h"
+#include "Maps/CellPositionIndex.h"
 #include "Grids/CellImpl.h"
 #include "Grids/GridNotifiers.h"
 #include "Grids/GridNotifiersImpl.h"
@@ -69,15 +70,14 @@ Object::~Object()
         MANGOS_ASSERT(false);
     }
 
-    delete[] m_uint32Values;
+    GetUpdateValuesPool().Free(m_uint32Values, m_valuesCount);
 
     delete loot;
 }
 
 void Object::_InitValues()
 {
-    m_uint32Values = new uint32[ m_valuesCount ];
-    memset(m_uint32Values, 0, m_valuesCount * sizeof(uint32));
+    m_uint32Values = GetUpdateValuesPool().Allocate(m_valuesCount);
 
     m_changedValues.resize(m_valuesCount, false);
 
@@ -209,6 +209,42 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) c
     data->AddUpdateBlock(buf);
 }
 
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, SharedValuesUpdate& shared) const
+{
+    // players see more of their own fields than other players do, any other mask difference is not viewer dependent
+    SharedValuesUpdate::Block& block = shared.blocks[target == this ? 1 : 0];
+
+    if (!block.built)
+    {
+        block.data.reserve(500);
+        block.data << uint8(UPDATETYPE_VALUES);
+        block.data << GetPackGUID();
+
+        UpdateMask updateMask;
+        updateMask.SetCount(m_valuesCount);
+
+        _SetUpdateBits(&updateMask, target);
+        BuildValuesUpdate(UPDATETYPE_VALUES, &block.data, &updateMask, target, &block.patches);
+        block.built = true;
+
+        // built for this viewer already
+        data->AddUpdateBlock(block.data);
+        return;
+    }
+
+    if (block.patches.empty())
+    {
+        data->AddUpdateBlock(block.data);
+        return;
+    }
+
+    ByteBuffer buf(block.data);
+    for (UpdateFieldPatches::const_iterator itr = block.patches.begin(); itr != block.patches.end(); ++itr)
+        buf.put<uint32>(itr->first, GetUpdateFieldValueFor(itr->second, target));
+
+    data->AddUpdateBlock(buf);
+}
+
 void Object::BuildOutOfRangeUpdateBlock(UpdateData* data) const
 {
     data->AddOutOfRangeGUID(GetObjectGuid());
@@ -343,50 +379,21 @@ void Object::BuildMovementUpdate(ByteBuffer* data, uint8 updateFlags) const
     }
 }
 
-void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const
+void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target, UpdateFieldPatches* patches) const
 {
     if (!target)
         return;
 
-    bool IsActivateToQuest = false;
-    bool IsPerCasterAuraState = false;
-
-    if (updatetype == UPDATETYPE_CREATE_OBJECT || updatetype == UPDATETYPE_CREATE_OBJECT2)
+    if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
     {
-        if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
-        {
-            if (((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster())
-                IsActivateToQuest = true;
-
-            updateMask->SetBit(GAMEOBJECT_DYN_FLAGS);
-        }
-        else if (isType(TYPEMASK_UNIT))
-        {
-            if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
-            {
-                IsPerCasterAuraState = true;
-                updateMask->SetBit(UNIT_FIELD_AURASTATE);
-            }
-        }
+        updateMask->SetBit(GAMEOBJECT_DYN_FLAGS);
+        if (updatetype == UPDATETYPE_VALUES)
+            updateMask->SetBit(GAMEOBJECT_ANIMPROGRESS);
     }
-    else                                                    // case UPDATETYPE_VALUES
+    else if (isType(TYPEMASK_UNIT))
     {
-        if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
-        {
-            if (((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster())
-                IsActivateToQuest = true;
-
-            updateMask->SetBit(GAMEOBJECT_DYN_FLAGS);
-            updateMask->SetBit(GAMEOBJECT_ANIMPROGRESS);
-        }
-        else if (isType(TYPEMASK_UNIT))
-        {
-            if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
-            {
-                IsPerCasterAuraState = true;
-                updateMask->SetBit(UNIT_FIELD_AURASTATE);
-            }
-        }
+        if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
+            updateMask->SetBit(UNIT_FIELD_AURASTATE);
     }
 
     MANGOS_ASSERT(updateMask && updateMask->GetCount() == m_valuesCount);
@@ -394,245 +401,225 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
     *data << (uint8)updateMask->GetBlockCount();
     data->append(updateMask->GetMask(), updateMask->GetLength());
 
-    // 2 specialized loops for speed optimization in non-unit case
-    if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
+    // values only differing per viewer are remembered to let the block be reused for other viewers
+    updateMask->ForEachSetBit([&](uint16 index)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
-        {
-            if (updateMask->GetBit(index))
-            {
-                if (index == UNIT_NPC_FLAGS)
-                {
-                    uint32 appendValue = m_uint32Values[index];
+        if (patches && IsViewerDependentUpdateField(index))
+            patches->push_back(UpdateFieldPatches::value_type(data->wpos(), index));
 
-                    if (GetTypeId() == TYPEID_UNIT)
-                    {
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->IsTrainerOf(target, false))
-                                appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
-                        }
+        *data << GetUpdateFieldValueFor(index, target);
+    });
+}
 
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                        }
+// stat fields hidden from non-allied players by the fog of war settings
+static bool IsFogOfWarStatField(uint16 index)
+{
+    return index == UNIT_FIELD_RANGEDATTACKTIME ||
+           index == UNIT_FIELD_MINDAMAGE || index == UNIT_FIELD_MAXDAMAGE ||
+           index == UNIT_FIELD_MINOFFHANDDAMAGE || index == UNIT_FIELD_MAXOFFHANDDAMAGE ||
+           (index >= UNIT_FIELD_STAT0 && index < UNIT_FIELD_BASE_MANA) ||
+           index == UNIT_FIELD_BASE_HEALTH || index == UNIT_FIELD_ATTACK_POWER ||
+           index == UNIT_FIELD_ATTACK_POWER_MODS || index == UNIT_FIELD_ATTACK_POWER_MULTIPLIER ||
+           index == UNIT_FIELD_RANGED_ATTACK_POWER || index == UNIT_FIELD_RANGED_ATTACK_POWER_MODS ||
+           index == UNIT_FIELD_RANGED_ATTACK_POWER_MULTIPLIER || index == UNIT_FIELD_MINRANGEDDAMAGE ||
+           index == UNIT_FIELD_MAXRANGEDDAMAGE || (index >= UNIT_FIELD_POWER_COST_MODIFIER && index <= UNIT_FIELD_MAXHEALTHMODIFIER);
+}
 
-                        if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
-                        {
-                            QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
-                            {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanSeeStartQuest(pQuest))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
-                            }
-
-                            bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
-                            {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanRewardQuest(pQuest, false))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
-                            }
-                        }
-                    }
+bool Object::IsViewerDependentUpdateField(uint16 index) const
+{
+    if (isType(TYPEMASK_UNIT))
+        return index == UNIT_NPC_FLAGS || index == UNIT_FIELD_AURASTATE || index == UNIT_FIELD_FLAGS || index == UNIT_DYNAMIC_FLAGS ||
+               index == UNIT_FIELD_HEALTH || index == UNIT_FIELD_MAXHEALTH || IsFogOfWarStatField(index);
 
-                    *data << uint32(appendValue);
-                }
-                else if (index == UNIT_FIELD_AURASTATE)
-                {
-                    if (IsPerCasterAuraState)
-                    {
-                        // IsPerCasterAuraState set if related pet caster aura state set already
-                        if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
-                            *data << m_uint32Values[index];
-                        else
-                            *data << (m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1)));
-                    }
-                    else
-                        *data << m_uint32Values[index];
-                }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-                {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
-                }
+    if (isType(TYPEMASK_GAMEOBJECT))
+        return index == GAMEOBJECT_DYN_FLAGS;
 
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                         (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
-                {
-                    *data << uint32(m_floatValues[index]);
-                }
+    return false;
+}
 
-                // Fog of War: replace absolute health values with percentages for non-allied units according to settings
-                else if ((index == UNIT_FIELD_HEALTH || index == UNIT_FIELD_MAXHEALTH) &&
-                         !(static_cast<const Unit*>(this))->IsFogOfWarVisibleHealth(target))
-                {
-                    *data << uint32(index == UNIT_FIELD_MAXHEALTH ? 100 : ceil(100.0 * m_uint32Values[UNIT_FIELD_HEALTH] / m_uint32Values[UNIT_FIELD_MAXHEALTH]));
-                }
+uint32 Object::GetUpdateFieldValueFor(uint16 index, Player* target) const
+{
+    if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
+    {
+        if (index == UNIT_NPC_FLAGS)
+        {
+            uint32 appendValue = m_uint32Values[index];
 
-                // Fog of War: hide stat values for non-allied units according to settings
-                else if ((index == UNIT_FIELD_RANGEDATTACKTIME ||
-                          index == UNIT_FIELD_MINDAMAGE || index == UNIT_FIELD_MAXDAMAGE ||
-                          index == UNIT_FIELD_MINOFFHANDDAMAGE || index == UNIT_FIELD_MAXOFFHANDDAMAGE ||
-                          index == UNIT_FIELD_MINOFFHANDDAMAGE || (index >= UNIT_FIELD_STAT0 && index < UNIT_FIELD_BASE_MANA) ||
-                          index == UNIT_FIELD_BASE_HEALTH || index == UNIT_FIELD_ATTACK_POWER ||
-                          index == UNIT_FIELD_ATTACK_POWER_MODS || index == UNIT_FIELD_ATTACK_POWER_MULTIPLIER ||
-                          index == UNIT_FIELD_RANGED_ATTACK_POWER || index == UNIT_FIELD_RANGED_ATTACK_POWER_MODS ||
-                          index == UNIT_FIELD_RANGED_ATTACK_POWER_MULTIPLIER || index == UNIT_FIELD_MINRANGEDDAMAGE ||
-                          index == UNIT_FIELD_MAXRANGEDDAMAGE || (index >= UNIT_FIELD_POWER_COST_MODIFIER && index <= UNIT_FIELD_MAXHEALTHMODIFIER)) &&
-                          !(static_cast<const Unit*>(this))->IsFogOfWarVisibleStats(target))
+            if (GetTypeId() == TYPEID_UNIT)
+            {
+                if (appendValue & UNIT_NPC_FLAG_TRAINER)
                 {
-                    *data << uint32(0);
+                    if (!((Creature*)this)->IsTrainerOf(target, false))
+                        appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
                 }
 
-                // Gamemasters should be always able to select units - remove not selectable flag
-                else if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
+                if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
                 {
-                    *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
+                    if (target->getClass() != CLASS_HUNTER)
+                        appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
                 }
-                // Hide lootable animation for unallowed players
-                // Handle tapped flag
-                else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
-                {
-                    Creature* creature = (Creature*)this;
-                    uint32 dynflagsValue = m_uint32Values[index];
-                    bool setTapFlags = false;
-
-                    if (creature->isAlive())
-                    {
-                        // creature is alive so, not lootable
-                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
 
-                        if (creature->isInCombat())
-                        {
-                            // as creature is in combat we have to manage tap flags
-                            setTapFlags = true;
-                        }
-                        else
-                        {
-                            // creature is not in combat so its not tapped
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
-                            //sLog.outString(">> %s is not in combat so not tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
-                        }
-                    }
-                    else
+                if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
+                {
+                    QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
+                    for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
                     {
-                        // check loot flag
-                        if (creature->loot && creature->loot->CanLoot(target))
-                        {
-                            // creature is dead and this player can loot it
-                            dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
-                            //sLog.outString(">> %s is lootable for %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
-                        }
-                        else
+                        Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                        if (target->CanSeeStartQuest(pQuest))
                         {
-                            // creature is dead but this player cannot loot it
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
-                            //sLog.outString(">> %s is not lootable for %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
+                            appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                            break;
                         }
-
-                        // as creature is died we have to manage tap flags
-                        setTapFlags = true;
                     }
 
-                    // check tap flags
-                    if (setTapFlags)
+                    bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
+                    for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
                     {
-                        if (creature->IsTappedBy(target))
+                        Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                        if (target->CanRewardQuest(pQuest, false))
                         {
-                            // creature is in combat or died and tapped by this player
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
-                            //sLog.outString(">> %s is tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
-                        }
-                        else
-                        {
-                            // creature is in combat or died but not tapped by this player
-                            dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
-                            //sLog.outString(">> %s is not tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
+                            appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                            break;
                         }
                     }
+                }
+            }
+
+            return appendValue;
+        }
+
+        if (index == UNIT_FIELD_AURASTATE)
+        {
+            // per caster aura state is only sent to the caster
+            if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE) && !((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
+                return m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1));
+
+            return m_uint32Values[index];
+        }
 
-                    *data << dynflagsValue;
+        // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+        if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+        {
+            // convert from float to uint32 and send
+            return uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+        }
+
+        // there are some float values which may be negative or can't get negative due to other checks
+        if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
+                (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+                (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+                (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
+        {
+            return uint32(m_floatValues[index]);
+        }
+
+        // Fog of War: replace absolute health values with percentages for non-allied units according to settings
+        if ((index == UNIT_FIELD_HEALTH || index == UNIT_FIELD_MAXHEALTH) &&
+                !(static_cast<const Unit*>(this))->IsFogOfWarVisibleHealth(target))
+        {
+            return uint32(index == UNIT_FIELD_MAXHEALTH ? 100 : ceil(100.0 * m_uint32Values[UNIT_FIELD_HEALTH] / m_uint32Values[UNIT_FIELD_MAXHEALTH]));
+        }
+
+        // Fog of War: hide stat values for non-allied units according to settings
+        if (IsFogOfWarStatField(index) && !(static_cast<const Unit*>(this))->IsFogOfWarVisibleStats(target))
+            return 0;
+
+        // Gamemasters should be always able to select units - remove not selectable flag
+        if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
+            return m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE;
+
+        // Hide lootable animation for unallowed players
+        // Handle tapped flag
+        if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
+        {
+            Creature* creature = (Creature*)this;
+            uint32 dynflagsValue = m_uint32Values[index];
+            bool setTapFlags = false;
+
+            if (creature->isAlive())
+            {
+                // creature is alive so, not lootable
+                dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
+
+                if (creature->isInCombat())
+                {
+                    // as creature is in combat we have to manage tap flags
+                    setTapFlags = true;
                 }
-                else                                        // Unhandled index, just send
+                else
                 {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
+                    // creature is not in combat so its not tapped
+                    dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
                 }
             }
-        }
-    }
-    else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
-    {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
-        {
-            if (updateMask->GetBit(index))
+            else
             {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYN_FLAGS)
+                // check loot flag
+                if (creature->loot && creature->loot->CanLoot(target))
+                {
+                    // creature is dead and this player can loot it
+                    dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
+                }
+                else
                 {
-                    // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
-                    //      most likely related to "can enter map" and then should be 0 if can not enter
+                    // creature is dead but this player cannot loot it
+                    dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
+                }
 
-                    if (IsActivateToQuest)
-                    {
-                        GameObject const* gameObject = static_cast<GameObject const*>(this);
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                *data << uint16(0);
-                                break;
-                            case GAMEOBJECT_TYPE_CHEST:
-                                if (gameObject->getLootState() == GO_READY || gameObject->getLootState() == GO_ACTIVATED)
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                else
-                                    *data << uint16(0);
-                                *data << uint16(0);
-                                break;
-                            case GAMEOBJECT_TYPE_GENERIC:
-                            case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                *data << uint16(0);
-                                break;
-                            default:
-                                *data << uint32(0);         // unknown, not happen.
-                                break;
-                        }
-                    }
-                    else
-                        *data << uint32(0);                 // disable quest object
+                // as creature is died we have to manage tap flags
+                setTapFlags = true;
+            }
+
+            // check tap flags
+            if (setTapFlags)
+            {
+                if (creature->IsTappedBy(target))
+                {
+                    // creature is in combat or died and tapped by this player
+                    dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
                 }
                 else
-                    *data << m_uint32Values[index];         // other cases
+                {
+                    // creature is in combat or died but not tapped by this player
+                    dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
+                }
             }
+
+            return dynflagsValue;
         }
     }
-    else                                                    // other objects case (no special index checks)
+    else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        if (index == GAMEOBJECT_DYN_FLAGS)
         {
-            if (updateMask->GetBit(index))
+            // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
+            //      most likely related to "can enter map" and then should be 0 if can not enter
+
+            GameObject const* gameObject = static_cast<GameObject const*>(this);
+            if (gameObject->IsTransport() || (!gameObject->ActivateToQuest(target) && !target->isGameMaster()))
+                return 0;                                   // disable quest object
+
+            // lo part is the flags, hi part is unused
+            switch (gameObject->GetGoType())
             {
-                // send in current format (float as float, uint32 as uint32)
-                *data << m_uint32Values[index];
+                case GAMEOBJECT_TYPE_QUESTGIVER:
+                    return GO_DYNFLAG_LO_ACTIVATE;
+                case GAMEOBJECT_TYPE_CHEST:
+                    if (gameObject->getLootState() == GO_READY || gameObject->getLootState() == GO_ACTIVATED)
+                        return GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                    return 0;
+                case GAMEOBJECT_TYPE_GENERIC:
+                case GAMEOBJECT_TYPE_SPELL_FOCUS:
+                case GAMEOBJECT_TYPE_GOOBER:
+                    return GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                default:
+                    return 0;                               // unknown, not happen.
             }
         }
     }
+
+    // send in current format (float as float, uint32 as uint32)
+    return m_uint32Values[index];
 }
 
 void Object::ClearUpdateMask(bool remove)
@@ -730,6 +717,9 @@ void Object::SetFloatValue(uint16 index, float value)
         m_floatValues[index] = value;
         m_changedValues[index] = true;
         MarkForClientUpdate();
+
+        if (index == UNIT_FIELD_BOUNDINGRADIUS && isType(TYPEMASK_UNIT))
+            static_cast<WorldObject*>(this)->UpdateCellPositionRadius();
     }
 }
 
@@ -924,7 +914,7 @@ bool Object::PrintEntryError(char const* descr) const
 }
 
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, SharedValuesUpdate* shared) const
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -935,7 +925,10 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (shared)
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, *shared);
+    else
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
 }
 
 void Object::AddToClientUpdateList()
@@ -981,10 +974,17 @@ void Object::ForceValuesUpdateAtIndex(uint32 index)
 WorldObject::WorldObject() :
     m_transportInfo(nullptr), m_isOnEventNotified(false),
     m_currMap(nullptr), m_mapId(0),
-    m_InstanceId(0), m_isActiveObject(false)
+    m_InstanceId(0), m_isActiveObject(false),
+    m_cellPositionIndex(nullptr), m_cellPositionSlot(0)
 {
 }
 
+WorldObject::~WorldObject()
+{
+    // normally already done by Map::RemoveFromGrid
+    CellPositionIndex::Remove(this);
+}
+
 void WorldObject::CleanupsBeforeDelete()
 {
     RemoveFromWorld();
@@ -1002,6 +1002,9 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
     m_position.z = z;
     m_position.o = orientation;
 
+    if (m_cellPositionIndex)
+        m_cellPositionIndex->Relocate(m_cellPositionSlot, x, y);
+
     if (isType(TYPEMASK_UNIT))
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, orientation);
 }
@@ -1012,10 +1015,19 @@ void WorldObject::Relocate(float x, float y, float z)
     m_position.y = y;
     m_position.z = z;
 
+    if (m_cellPositionIndex)
+        m_cellPositionIndex->Relocate(m_cellPositionSlot, x, y);
+
     if (isType(TYPEMASK_UNIT))
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, GetOrientation());
 }
 
+void WorldObject::UpdateCellPositionRadius()
+{
+    if (m_cellPositionIndex)
+        m_cellPositionIndex->SetBoundingRadius(m_cellPositionSlot, GetObjectBoundingRadius());
+}
+
 void WorldObject::SetOrientation(float orientation)
 {
     m_position.o = orientation;
@@ -2027,12 +2039,13 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
+    SharedValuesUpdate i_shared;                            // changed values are serialized once for all viewers
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj)
     {
         // send self fields changes in another way, otherwise
         // with new camera system when player's camera too far from player, camera wouldn't receive packets and changes from player
         if (i_object.isType(TYPEMASK_PLAYER))
-            i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas);
+            i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas, &i_shared);
     }
 
     void Visit(CameraMapType& m)
@@ -2041,7 +2054,7 @@ struct WorldObjectChangeAccumulator
         {
             Player* owner = iter->getSource()->GetOwner();
             if (owner != &i_object && owner->HaveAtClient(&i_object))
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, &i_shared);
         }
     }
 
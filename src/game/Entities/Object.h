@@ -24,6 +24,7 @@
 #include "Entities/UpdateFields.h"
 #include "Entities/UpdateData.h"
 #include "Entities/ObjectGuid.h"
+#include "Entities/ObjectPool.h"
 #include "Globals/SharedDefines.h"
 #include "Camera.h"
 #include "Server/DBCStructure.h"
@@ -106,6 +107,7 @@ class UpdateMask;
 class InstanceData;
 class TerrainInfo;
 class TransportInfo;
+class CellPositionIndex;
 struct MangosStringLocale;
 class Loot;
 struct ItemPrototype;
@@ -114,6 +116,24 @@ struct SpellEntry;
 
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 
+// offset in a values update block and index of the fields whose value depends on the viewer
+typedef std::vector<std::pair<size_t, uint16> > UpdateFieldPatches;
+
+// values update blocks of an object built once per client update and reused for all its viewers
+struct SharedValuesUpdate
+{
+    struct Block
+    {
+        Block() : data(0), built(false) {}
+
+        ByteBuffer data;
+        UpdateFieldPatches patches;                         // rewritten for every viewer
+        bool built;
+    };
+
+    Block blocks[2];                                        // for other players and for the player itself
+};
+
 // cooldown system
 typedef std::chrono::system_clock Clock;
 typedef std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds> TimePoint;
@@ -365,6 +385,7 @@ class Object
 
         uint8 GetTypeId() const { return m_objectTypeId; }
         bool isType(TypeMask mask) const { return !!(mask & m_objectType); }
+        uint16 GetTypeMask() const { return m_objectType; }
 
         virtual void BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) const;
         void SendCreateUpdateToPlayer(Player* player) const;
@@ -377,6 +398,7 @@ class Object
         void SendForcedObjectUpdate();
 
         void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, SharedValuesUpdate& shared) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
         void BuildMovementUpdateBlock(UpdateData* data, uint8 flags = 0) const;
 
@@ -586,8 +608,11 @@ class Object
         virtual void _SetCreateBits(UpdateMask* updateMask, Player* target) const;
 
         void BuildMovementUpdate(ByteBuffer* data, uint8 updateFlags) const;
-        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const;
+        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target, UpdateFieldPatches* patches = nullptr) const;
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, SharedValuesUpdate* shared = nullptr) const;
+
+        bool IsViewerDependentUpdateField(uint16 index) const;
+        uint32 GetUpdateFieldValueFor(uint16 index, Player* target) const;
 
         uint16 m_objectType;
 
@@ -627,6 +652,7 @@ struct WorldObjectChangeAccumulator;
 class WorldObject : public Object
 {
         friend struct WorldObjectChangeAccumulator;
+        friend class CellPositionIndex;
 
     public:
 
@@ -644,6 +670,9 @@ class WorldObject : public Object
                     m_obj->m_updateTracker.Reset();
                 }
 
+                // time since the last update of the object
+                uint32 GetTimeElapsed() { return uint32(m_obj->m_updateTracker.timeElapsed()); }
+
             private:
                 UpdateHelper(const UpdateHelper&);
                 UpdateHelper& operator=(const UpdateHelper&);
@@ -651,7 +680,7 @@ class WorldObject : public Object
                 WorldObject* const m_obj;
         };
 
-        virtual ~WorldObject() {}
+        virtual ~WorldObject();
 
         virtual void Update(uint32 /*update_diff*/, uint32 /*time_diff*/) {}
 
@@ -663,6 +692,8 @@ class WorldObject : public Object
 
         void Relocate(float x, float y, float z, float orientation);
         void Relocate(float x, float y, float z);
+        // called when UNIT_FIELD_BOUNDINGRADIUS changes, keeps the cell position index in sync
+        void UpdateCellPositionRadius();
 
         void SetOrientation(float orientation);
 
@@ -914,6 +945,9 @@ class WorldObject : public Object
         ViewPoint m_viewPoint;
         WorldUpdateCounter m_updateTracker;
         bool m_isActiveObject;
+
+        CellPositionIndex* m_cellPositionIndex;             // set while a player or creature is in a grid cell
+        uint32 m_cellPositionSlot;
 };
 
 #endif
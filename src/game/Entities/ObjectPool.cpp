@@ -0,0 +1,137 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Entities/ObjectPool.h"
+
+#include <cstddef>
+
+size_t ObjectSlabAllocator::GetBlockSize(size_t size)
+{
+    size_t const align = alignof(std::max_align_t);
+    return (std::max(size, sizeof(FreeBlock)) + align - 1) & ~(align - 1);
+}
+
+void* ObjectSlabAllocator::Allocate(size_t size)
+{
+    size_t blockSize = GetBlockSize(size);
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    FreeBlock*& freeList = m_freeLists[blockSize];
+    if (!freeList)
+    {
+        // new slab, all its blocks go to the free list
+        char* slab = static_cast<char*>(::operator new(blockSize * m_slabObjects));
+        for (uint32 i = m_slabObjects; i > 0; --i)
+        {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * blockSize);
+            block->next = freeList;
+            freeList = block;
+        }
+    }
+
+    FreeBlock* block = freeList;
+    freeList = block->next;
+    return block;
+}
+
+void ObjectSlabAllocator::Free(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    FreeBlock*& freeList = m_freeLists[GetBlockSize(size)];
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = freeList;
+    freeList = block;
+}
+
+uint32* UpdateValuesPool::Allocate(uint16 count)
+{
+    uint32* values = nullptr;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        std::vector<uint32*>& freeArrays = m_freeArrays[count];
+        if (!freeArrays.empty())
+        {
+            values = freeArrays.back();
+            freeArrays.pop_back();
+        }
+    }
+
+    if (!values)
+        values = new uint32[count];
+
+    memset(values, 0, count * sizeof(uint32));
+    return values;
+}
+
+void UpdateValuesPool::Free(uint32* values, uint16 count)
+{
+    if (!values)
+        return;
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_freeArrays[count].push_back(values);
+}
+
+ObjectSlabAllocator& GetCreatureAllocator()
+{
+    static ObjectSlabAllocator* allocator = new ObjectSlabAllocator("Creature");
+    return *allocator;
+}
+
+ObjectSlabAllocator& GetGameObjectAllocator()
+{
+    static ObjectSlabAllocator* allocator = new ObjectSlabAllocator("GameObject");
+    return *allocator;
+}
+
+ObjectSlabAllocator& GetItemAllocator()
+{
+    static ObjectSlabAllocator* allocator = new ObjectSlabAllocator("Item", 256);
+    return *allocator;
+}
+
+ObjectSlabAllocator& GetDynamicObjectAllocator()
+{
+    static ObjectSlabAllocator* allocator = new ObjectSlabAllocator("DynamicObject");
+    return *allocator;
+}
+
+ObjectSlabAllocator& GetSpellAllocator()
+{
+    static ObjectSlabAllocator* allocator = new ObjectSlabAllocator("Spell");
+    return *allocator;
+}
+
+ObjectSlabAllocator& GetSpellEventAllocator()
+{
+    static ObjectSlabAllocator* allocator = new ObjectSlabAllocator("SpellEvent", 256);
+    return *allocator;
+}
+
+UpdateValuesPool& GetUpdateValuesPool()
+{
+    static UpdateValuesPool* pool = new UpdateValuesPool();
+    return *pool;
+}
@@ -0,0 +1,83 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_OBJECT_POOL_H
+#define MANGOS_OBJECT_POOL_H
+
+#include "Common.h"
+
+#include <mutex>
+
+/// Allocator for objects that are created and deleted all the time (grid load/unload, loot, login)
+/// Memory is taken from slabs holding several objects of the same size and freed objects are kept in
+/// a free list of their size for reuse, slabs are never given back. Derived classes get their own size class.
+class ObjectSlabAllocator
+{
+    public:
+        explicit ObjectSlabAllocator(char const* name, uint32 slabObjects = 64) : m_name(name), m_slabObjects(slabObjects) {}
+
+        void* Allocate(size_t size);
+        void Free(void* ptr, size_t size);
+
+        char const* GetName() const { return m_name; }
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        static size_t GetBlockSize(size_t size);
+
+        typedef std::unordered_map<size_t, FreeBlock*> FreeListMap;
+
+        char const* m_name;
+        uint32 m_slabObjects;
+        FreeListMap m_freeLists;                            // block size -> first free block
+        std::mutex m_mutex;
+};
+
+/// Recycles the update field arrays (m_uint32Values) of objects, one free list per field count
+class UpdateValuesPool
+{
+    public:
+        uint32* Allocate(uint16 count);
+        void Free(uint32* values, uint16 count);
+
+    private:
+        typedef std::unordered_map<uint16, std::vector<uint32*> > FreeArraysMap;
+
+        FreeArraysMap m_freeArrays;
+        std::mutex m_mutex;
+};
+
+// never destroyed, objects may still be deleted during static destruction
+ObjectSlabAllocator& GetCreatureAllocator();
+ObjectSlabAllocator& GetGameObjectAllocator();
+ObjectSlabAllocator& GetItemAllocator();
+ObjectSlabAllocator& GetDynamicObjectAllocator();
+ObjectSlabAllocator& GetSpellAllocator();
+ObjectSlabAllocator& GetSpellEventAllocator();
+UpdateValuesPool& GetUpdateValuesPool();
+
+/// Declares class specific operator new/delete taking the memory from an ObjectSlabAllocator
+#define DECLARE_SLAB_ALLOCATED(ALLOCATOR)                                                   \
+    static void* operator new(size_t size) { return ALLOCATOR().Allocate(size); }           \
+    static void operator delete(void* ptr, size_t size) { ALLOCATOR().Free(ptr, size); }
+
+#endif
@@ -398,6 +398,8 @@ Player::Player(WorldSession* session): Unit(), m_taxiTracker(*this), m_mover(thi
     SetGroupInvite(nullptr);
     m_groupUpdateMask = 0;
     m_auraUpdateMask = 0;
+    m_groupHealthUpdateTimer = 0;
+    m_groupPositionUpdateTimer = 0;
 
     duel = nullptr;
 
@@ -1343,7 +1345,7 @@ void Player::Update(uint32 update_diff, uint32 p_time)
         m_createdInstanceClearTimer -= update_diff;
 
     // Group update
-    SendUpdateToOutOfRangeGroupMembers();
+    SendUpdateToOutOfRangeGroupMembers(update_diff);
 
     Pet* pet = GetPet();
     if (pet && !pet->IsWithinDistInMap(this, GetMap()->GetVisibilityDistance()) && (GetCharmGuid() && (pet->GetObjectGuid() != GetCharmGuid())))
@@ -18883,13 +18885,35 @@ void Player::SendInitialPacketsAfterAddToMap()
     SendItemDurations();                                    // must be after add to map
 }
 
-void Player::SendUpdateToOutOfRangeGroupMembers()
+void Player::SendUpdateToOutOfRangeGroupMembers(uint32 diff)
 {
+    m_groupHealthUpdateTimer = m_groupHealthUpdateTimer > diff ? m_groupHealthUpdateTimer - diff : 0;
+    m_groupPositionUpdateTimer = m_groupPositionUpdateTimer > diff ? m_groupPositionUpdateTimer - diff : 0;
+
     if (m_groupUpdateMask == GROUP_UPDATE_FLAG_NONE)
         return;
+
+    // health, power and position changes are coalesced until their interval passed,
+    // any other change sends them along with it
+    uint32 delayedMask = GROUP_UPDATE_FLAG_NONE;
+    if (m_groupHealthUpdateTimer)
+        delayedMask |= GROUP_UPDATE_HEALTH_POWER;
+    if (m_groupPositionUpdateTimer)
+        delayedMask |= GROUP_UPDATE_FLAG_POSITION;
+
+    if ((m_groupUpdateMask & ~delayedMask) == GROUP_UPDATE_FLAG_NONE)
+        return;
+
     if (Group* group = GetGroup())
+    {
         group->UpdatePlayerOutOfRange(this);
 
+        if (m_groupUpdateMask & GROUP_UPDATE_HEALTH_POWER)
+            m_groupHealthUpdateTimer = sWorld.getConfig(CONFIG_UINT32_GROUP_HEALTH_UPDATE_INTERVAL);
+        if (m_groupUpdateMask & GROUP_UPDATE_FLAG_POSITION)
+            m_groupPositionUpdateTimer = sWorld.getConfig(CONFIG_UINT32_GROUP_POSITION_UPDATE_INTERVAL);
+    }
+
     m_groupUpdateMask = GROUP_UPDATE_FLAG_NONE;
     m_auraUpdateMask = 0;
     if (Pet* pet = GetPet())
@@ -1589,7 +1589,7 @@ class Player : public Unit
         void UninviteFromGroup();
         static void RemoveFromGroup(Group* group, ObjectGuid guid);
         void RemoveFromGroup() { RemoveFromGroup(GetGroup(), GetObjectGuid()); }
-        void SendUpdateToOutOfRangeGroupMembers();
+        void SendUpdateToOutOfRangeGroupMembers(uint32 diff);
 
         void SetInGuild(uint32 GuildId) { SetUInt32Value(PLAYER_GUILDID, GuildId); }
         void SetRank(uint32 rankId) { SetUInt32Value(PLAYER_GUILDRANK, rankId); }
@@ -2411,6 +2411,8 @@ class Player : public Unit
         Group* m_groupInvite;
         uint32 m_groupUpdateMask;
         uint64 m_auraUpdateMask;
+        uint32 m_groupHealthUpdateTimer;                    // time until health/power changes can be sent to out of range members again
+        uint32 m_groupPositionUpdateTimer;                  // same for position changes
 
         // Player summoning
         time_t m_summon_expire;
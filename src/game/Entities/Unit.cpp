@@ -770,6 +770,9 @@ uint32 Unit::DealDamage(Unit* pVictim, uint32 damage, CleanDamage const* cleanDa
 
         ((Creature*)pVictim)->SetLootRecipient(this);
 
+        // a killing periodic tick has to reach the clients before the death
+        pVictim->GetMap()->SendPeriodicAuraLogs(pVictim);
+
         JustKilledCreature((Creature*)pVictim, nullptr);
         pVictim->SetHealth(0);
 
@@ -809,6 +812,9 @@ uint32 Unit::DealDamage(Unit* pVictim, uint32 damage, CleanDamage const* cleanDa
     {
         DEBUG_FILTER_LOG(LOG_FILTER_DAMAGE, "DealDamage %s Killed %s", GetGuidStr().c_str(), pVictim->GetGuidStr().c_str());
 
+        // a killing periodic tick has to reach the clients before the kill log and the death
+        pVictim->GetMap()->SendPeriodicAuraLogs(pVictim);
+
         /*
          *                      Preparation: Who gets credit for killing whom, invoke SpiritOfRedemtion?
          */
@@ -5351,12 +5357,13 @@ void Unit::SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* pInfo) const
 {
     Aura* aura = pInfo->aura;
     Modifier* mod = aura->GetModifier();
+    Unit* target = aura->GetTarget();
+
+    // without map there is nobody to send the log to
+    if (!target->IsInWorld())
+        return;
 
-    WorldPacket data(SMSG_PERIODICAURALOG, 30);
-    data << aura->GetTarget()->GetPackGUID();
-    data << aura->GetCasterGuid().WriteAsPacked();
-    data << uint32(aura->GetId());                          // spellId
-    data << uint32(1);                                      // count
+    ByteBuffer data(20);
     data << uint32(mod->m_auraname);                        // auraId
     switch (mod->m_auraname)
     {
@@ -5386,7 +5393,7 @@ void Unit::SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* pInfo) const
             return;
     }
 
-    aura->GetTarget()->SendMessageToSet(data, true);
+    target->GetMap()->AddPeriodicAuraLog(target, aura->GetCasterGuid(), aura->GetId(), data);
 }
 
 void Unit::ProcDamageAndSpell(Unit* pVictim, uint32 procAttacker, uint32 procVictim, uint32 procExtra, uint32 amount, WeaponAttackType attType, SpellEntry const* procSpell, bool dontTriggerSpecial)
@@ -21,6 +21,10 @@
 
 #include "Errors.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 class UpdateMask
 {
     public:
@@ -52,6 +56,24 @@ class UpdateMask
         uint32 GetCount() const { return mCount; }
         uint8* GetMask() { return (uint8*)mUpdateMask; }
 
+        // calls worker with the index of every set bit in increasing order, 64 bits are checked at once
+        template<typename Worker>
+        void ForEachSetBit(Worker const& worker) const
+        {
+            for (uint32 i = 0; i < mBlocks; i += 2)
+            {
+                uint64 bits = mUpdateMask[i];
+                if (i + 1 < mBlocks)
+                    bits |= uint64(mUpdateMask[i + 1]) << 32;
+
+                while (bits)
+                {
+                    worker(i * 32 + CountTrailingZeros(bits));
+                    bits &= bits - 1;
+                }
+            }
+        }
+
         void SetCount(uint32 valuesCount)
         {
             delete[] mUpdateMask;
@@ -114,6 +136,19 @@ class UpdateMask
         }
 
     private:
+        static uint32 CountTrailingZeros(uint64 value)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            if (_BitScanForward(&index, uint32(value)))
+                return index;
+            _BitScanForward(&index, uint32(value >> 32));
+            return index + 32;
+#else
+            return __builtin_ctzll(value);
+#endif
+        }
+
         uint32 mCount;
         uint32 mBlocks;
         uint32* mUpdateMask;
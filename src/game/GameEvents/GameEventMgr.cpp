@@ -733,6 +733,23 @@ void GameEventMgr::ApplyNewEvent(uint16 event_id, bool resume)
     OnEventHappened(event_id, true, resume);
 }
 
+typedef std::map<uint32 /*mapid*/, std::vector<MapSpawnWork> > SpawnWorkPerMap;
+
+// hands the collected spawn changes to all loaded maps with their map id, the maps apply them in their updates
+static void QueueSpawnWork(SpawnWorkPerMap const& spawnWork)
+{
+    for (SpawnWorkPerMap::const_iterator itr = spawnWork.begin(); itr != spawnWork.end(); ++itr)
+    {
+        std::vector<MapSpawnWork> const& mapWork = itr->second;
+        auto worker = [&mapWork](Map * map)
+        {
+            for (MapSpawnWork const& work : mapWork)
+                map->AddSpawnWork(work);
+        };
+        sMapMgr.DoForAllMapsWithMapId(itr->first, worker);
+    }
+}
+
 void GameEventMgr::GameEventSpawn(int16 event_id)
 {
     int32 internal_event_id = mGameEvent.size() + event_id - 1;
@@ -743,6 +760,7 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
         return;
     }
 
+    SpawnWorkPerMap spawnWork;
     for (GuidList::iterator itr = mGameEventCreatureGuids[internal_event_id].begin(); itr != mGameEventCreatureGuids[internal_event_id].end(); ++itr)
     {
         // Add to correct cell
@@ -763,9 +781,10 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
 
             sObjectMgr.AddCreatureToGrid(*itr, data);
 
-            Creature::SpawnInMaps(*itr, data);
+            spawnWork[data->mapid].push_back(MapSpawnWork(SPAWN_WORK_SPAWN_CREATURE, *itr));
         }
     }
+    QueueSpawnWork(spawnWork);
 
     if (internal_event_id < 0 || (size_t)internal_event_id >= mGameEventGameobjectGuids.size())
     {
@@ -773,6 +792,7 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
         return;
     }
 
+    spawnWork.clear();
     for (GuidList::iterator itr = mGameEventGameobjectGuids[internal_event_id].begin(); itr != mGameEventGameobjectGuids[internal_event_id].end(); ++itr)
     {
         // Add to correct cell
@@ -793,9 +813,10 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
 
             sObjectMgr.AddGameobjectToGrid(*itr, data);
 
-            GameObject::SpawnInMaps(*itr, data);
+            spawnWork[data->mapid].push_back(MapSpawnWork(SPAWN_WORK_SPAWN_GAMEOBJECT, *itr));
         }
     }
+    QueueSpawnWork(spawnWork);
 
     if (event_id > 0)
     {
@@ -820,6 +841,7 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         return;
     }
 
+    SpawnWorkPerMap spawnWork;
     for (GuidList::iterator itr = mGameEventCreatureGuids[internal_event_id].begin(); itr != mGameEventCreatureGuids[internal_event_id].end(); ++itr)
     {
         // Remove the creature from grid
@@ -840,9 +862,10 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
             sObjectMgr.RemoveCreatureFromGrid(*itr, data);
 
             // Remove spawned cases
-            Creature::AddToRemoveListInMaps(*itr, data);
+            spawnWork[data->mapid].push_back(MapSpawnWork(SPAWN_WORK_REMOVE_CREATURE, *itr));
         }
     }
+    QueueSpawnWork(spawnWork);
 
     if (internal_event_id < 0 || (size_t)internal_event_id >= mGameEventGameobjectGuids.size())
     {
@@ -850,6 +873,7 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         return;
     }
 
+    spawnWork.clear();
     for (GuidList::iterator itr = mGameEventGameobjectGuids[internal_event_id].begin(); itr != mGameEventGameobjectGuids[internal_event_id].end(); ++itr)
     {
         // Remove the gameobject from grid
@@ -870,9 +894,10 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
             sObjectMgr.RemoveGameobjectFromGrid(*itr, data);
 
             // Remove spawned cases
-            GameObject::AddToRemoveListInMaps(*itr, data);
+            spawnWork[data->mapid].push_back(MapSpawnWork(SPAWN_WORK_REMOVE_GAMEOBJECT, *itr));
         }
     }
+    QueueSpawnWork(spawnWork);
 
     if (event_id > 0)
     {
@@ -913,31 +938,9 @@ GameEventCreatureData const* GameEventMgr::GetCreatureUpdateDataForActiveEvent(u
     return nullptr;
 }
 
-struct GameEventUpdateCreatureDataInMapsWorker
-{
-    GameEventUpdateCreatureDataInMapsWorker(ObjectGuid guid, CreatureData const* data, GameEventCreatureData* event_data, bool activate)
-        : i_guid(guid), i_data(data), i_event_data(event_data), i_activate(activate) {}
-
-    void operator()(Map* map)
-    {
-        if (Creature* pCreature = map->GetCreature(i_guid))
-        {
-            pCreature->UpdateEntry(i_data->id, TEAM_NONE, i_data, i_activate ? i_event_data : nullptr);
-
-            // spells not casted for event remove case (sent nullptr into update), do it
-            if (!i_activate)
-                pCreature->ApplyGameEventSpells(i_event_data, false);
-        }
-    }
-
-    ObjectGuid i_guid;
-    CreatureData const* i_data;
-    GameEventCreatureData* i_event_data;
-    bool i_activate;
-};
-
 void GameEventMgr::UpdateCreatureData(int16 event_id, bool activate)
 {
+    SpawnWorkPerMap spawnWork;
     for (GameEventCreatureDataList::iterator itr = mGameEventCreatureData[event_id].begin(); itr != mGameEventCreatureData[event_id].end(); ++itr)
     {
         // Remove the creature from grid
@@ -946,9 +949,9 @@ void GameEventMgr::UpdateCreatureData(int16 event_id, bool activate)
             continue;
 
         // Update if spawned
-        GameEventUpdateCreatureDataInMapsWorker worker(data->GetObjectGuid(itr->first), data, &itr->second, activate);
-        sMapMgr.DoForAllMapsWithMapId(data->mapid, worker);
+        spawnWork[data->mapid].push_back(MapSpawnWork(activate ? SPAWN_WORK_APPLY_CREATURE_EVENT_DATA : SPAWN_WORK_RESTORE_CREATURE_EVENT_DATA, itr->first, &itr->second));
     }
+    QueueSpawnWork(spawnWork);
 }
 
 void GameEventMgr::UpdateEventQuests(uint16 event_id, bool Activate)
@@ -90,14 +90,32 @@ Player* ObjectAccessor::FindPlayer(ObjectGuid guid, bool inWorld /*= true*/)
 Player* ObjectAccessor::FindPlayerByName(const char* name)
 {
     HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (iter->second->IsInWorld() && (::strcmp(name, iter->second->GetName()) == 0))
-            return iter->second;
+    PlayerNameMapType const& names = sObjectAccessor.i_playerNames;
+    PlayerNameMapType::const_iterator itr = names.find(name);
+    if (itr != names.end() && itr->second->IsInWorld())
+        return itr->second;
 
     return nullptr;
 }
 
+void ObjectAccessor::AddObject(Player* object)
+{
+    HashMapHolder<Player>::Insert(object);
+
+    HashMapHolder<Player>::WriteGuard g(HashMapHolder<Player>::GetLock());
+    i_playerNames[object->GetName()] = object;
+}
+
+void ObjectAccessor::RemoveObject(Player* object)
+{
+    HashMapHolder<Player>::Remove(object);
+
+    HashMapHolder<Player>::WriteGuard g(HashMapHolder<Player>::GetLock());
+    PlayerNameMapType::iterator itr = i_playerNames.find(object->GetName());
+    if (itr != i_playerNames.end() && itr->second == object)
+        i_playerNames.erase(itr);
+}
+
 void
 ObjectAccessor::SaveAllPlayers() const
 {
@@ -90,6 +90,7 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
 
     public:
         typedef std::unordered_map<ObjectGuid, Corpse*> Player2CorpsesMapType;
+        typedef std::unordered_map<std::string, Player*> PlayerNameMapType;
 
         // Search player at any map in world and other objects at same map with `obj`
         // Note: recommended use Map::GetUnit version if player also expected at same map only
@@ -118,13 +119,14 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
 
         // For call from Player/Corpse AddToWorld/RemoveFromWorld only
         void AddObject(Corpse* object) { HashMapHolder<Corpse>::Insert(object); }
-        void AddObject(Player* object) { HashMapHolder<Player>::Insert(object); }
+        void AddObject(Player* object);
         void RemoveObject(Corpse* object) { HashMapHolder<Corpse>::Remove(object); }
-        void RemoveObject(Player* object) { HashMapHolder<Player>::Remove(object); }
+        void RemoveObject(Player* object);
 
     private:
 
         Player2CorpsesMapType   i_player2corpse;
+        PlayerNameMapType       i_playerNames;              // guarded by the HashMapHolder<Player> lock, names can't change while online
 
         typedef std::mutex LockType;
         typedef MaNGOS::GeneralLock<LockType > Guard;
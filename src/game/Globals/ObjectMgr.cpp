@@ -18,6 +18,7 @@
 
 #include "Globals/ObjectMgr.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/DatabaseImpl.h"
 #include "Policies/Singleton.h"
 
 #include "Server/SQLStorages.h"
@@ -134,7 +135,9 @@ ObjectMgr::ObjectMgr() :
     m_PetNumbers("Pet numbers"),
     m_FirstTemporaryCreatureGuid(1),
     m_FirstTemporaryGameObjectGuid(1),
-    DBCLocaleIndex(LOCALE_enUS)
+    DBCLocaleIndex(LOCALE_enUS),
+    m_oldMailsJobRunning(false),
+    m_oldMailsJobCount(0)
 {
 }
 
@@ -5104,120 +5107,208 @@ void ObjectMgr::LoadAreatriggerLocales()
     sLog.outString();
 }
 
-// not very fast function but it is called only once a day, or on starting-up
-/// @param serverUp true if the server is already running, false when the server is started
-void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
+// expired mails are read in chunks of this many rows (mail items included), so neither a query nor its handling can take long
+#define OLD_MAILS_CHUNK_SIZE 1000
+
+//                                          0    1             2        3          4             5            6          7
+#define OLD_MAILS_CHUNK_QUERY "SELECT m.id, m.messageType, m.sender, m.receiver, m.itemTextId, m.has_items, m.checked, mi.item_guid " \
+    "FROM mail m LEFT JOIN mail_items mi ON mi.mail_id = m.id WHERE m.expire_time < '" UI64FMTD "' AND m.id > '%u' ORDER BY m.id LIMIT %u"
+
+// executes "<statement> (id,id,...)" for a list of ids collected from one chunk
+static void ExecuteForIdList(char const* statement, std::vector<uint32> const& ids)
 {
-    time_t basetime = time(nullptr);
-    DEBUG_LOG("Returning mails current time: hour: %d, minute: %d, second: %d ", localtime(&basetime)->tm_hour, localtime(&basetime)->tm_min, localtime(&basetime)->tm_sec);
-    // delete all old mails without item and without body immediately, if starting server
-    if (!serverUp)
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND itemTextId = 0", (uint64)basetime);
-    //                                                     0  1           2      3        4          5         6           7   8       9
-    QueryResult* result = CharacterDatabase.PQuery("SELECT id,messageType,sender,receiver,itemTextId,has_items,expire_time,cod,checked,mailTemplateId FROM mail WHERE expire_time < '" UI64FMTD "'", (uint64)basetime);
-    if (!result)
+    if (ids.empty())
+        return;
+
+    std::ostringstream ss;
+    ss << statement << " (";
+    for (std::vector<uint32>::const_iterator itr = ids.begin(); itr != ids.end(); ++itr)
+        ss << (itr != ids.begin() ? "," : "") << *itr;
+    ss << ")";
+
+    CharacterDatabase.Execute(ss.str().c_str());
+}
+
+/// Returns or deletes the mails of one chunk with a few multi-row statements
+/// @param lastMailId id of the last mail of the previous chunk, set to the last mail handled by this one
+/// @return true if there can be more expired mails after this chunk
+bool ObjectMgr::ReturnOrDeleteOldMailsChunk(QueryResult* result, time_t basetime, bool serverUp, uint32& lastMailId, uint32& count)
+{
+    struct OldMailRow
     {
-        BarGoLink bar(1);
-        bar.step();
-        sLog.outString(">> Only expired mails (need to be return or delete) or DB table `mail` is empty.");
-        sLog.outString();
-        return;                                             // any mails need to be returned or deleted
+        uint32 mailId;
+        uint8 messageType;
+        uint32 sender;
+        uint32 receiver;
+        uint32 itemTextId;
+        bool hasItems;
+        uint32 checked;
+        uint32 itemGuid;
+    };
+
+    std::vector<OldMailRow> rows;
+    rows.reserve(result->GetRowCount());
+    do
+    {
+        Field* fields = result->Fetch();
+        OldMailRow row;
+        row.mailId = fields[0].GetUInt32();
+        row.messageType = fields[1].GetUInt8();
+        row.sender = fields[2].GetUInt32();
+        row.receiver = fields[3].GetUInt32();
+        row.itemTextId = fields[4].GetUInt32();
+        row.hasItems = fields[5].GetBool();
+        row.checked = fields[6].GetUInt32();
+        row.itemGuid = fields[7].GetUInt32();                // null if the mail has no items
+        rows.push_back(row);
     }
+    while (result->NextRow());
 
-    // std::ostringstream delitems, delmails; // will be here for optimization
-    // bool deletemail = false, deleteitem = false;
-    // delitems << "DELETE FROM item_instance WHERE guid IN ( ";
-    // delmails << "DELETE FROM mail WHERE id IN ( "
+    // the rows of the last mail can continue in the next chunk if the limit was hit, it is handled there as a whole
+    bool hasMore = rows.size() >= OLD_MAILS_CHUNK_SIZE;
+    uint32 lastCompleteMailId = rows.back().mailId;
+    if (hasMore && rows.front().mailId != lastCompleteMailId)
+    {
+        std::vector<OldMailRow>::const_reverse_iterator itr = rows.rbegin();
+        while (itr->mailId == lastCompleteMailId)
+            ++itr;
+        lastCompleteMailId = itr->mailId;
+    }
 
-    BarGoLink bar(result->GetRowCount());
-    uint32 count = 0;
-    Field* fields;
+    std::vector<uint32> delMails, delItemTexts, delItems;
 
-    do
+    struct ReturnedMails
     {
-        bar.step();
+        std::vector<uint32> mails;
+        std::vector<uint32> items;
+    };
+    // returned mails grouped by (old sender, old receiver), as every pair needs its own values
+    std::map<std::pair<uint32, uint32>, ReturnedMails> returnedMails;
 
-        fields = result->Fetch();
-        Mail* m = new Mail;
-        m->messageID = fields[0].GetUInt32();
-        m->messageType = fields[1].GetUInt8();
-        m->sender = fields[2].GetUInt32();
-        m->receiverGuid = ObjectGuid(HIGHGUID_PLAYER, fields[3].GetUInt32());
-        bool has_items = fields[5].GetBool();
-        m->expire_time = (time_t)fields[6].GetUInt64();
-        m->deliver_time = 0;
-        m->COD = fields[7].GetUInt32();
-        m->checked = fields[8].GetUInt32();
-        m->mailTemplateId = fields[9].GetInt16();
-
-        Player* pl = nullptr;
-        if (serverUp)
-            pl = GetPlayer(m->receiverGuid);
-        if (pl)
+    for (std::vector<OldMailRow>::const_iterator row = rows.begin(); row != rows.end() && row->mailId <= lastCompleteMailId; ++row)
+    {
+        // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
+        // his in mailbox and he has already listed his mails )
+        // the chunks are handled in the world thread, so the online check is safe here
+        if (serverUp && GetPlayer(ObjectGuid(HIGHGUID_PLAYER, row->receiver)))
+            continue;
+
+        // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
+        if (row->hasItems && row->messageType == MAIL_NORMAL && !(row->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
         {
-            // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
-            // his in mailbox and he has already listed his mails )
-            delete m;
+            ReturnedMails& returned = returnedMails[std::make_pair(row->sender, row->receiver)];
+            if (returned.mails.empty() || returned.mails.back() != row->mailId)
+                returned.mails.push_back(row->mailId);
+            if (row->itemGuid)
+                returned.items.push_back(row->itemGuid);
             continue;
         }
-        // delete or return mail:
-        if (has_items)
+
+        // mail open and then not returned
+        if (row->itemGuid)
+            delItems.push_back(row->itemGuid);
+
+        if (delMails.empty() || delMails.back() != row->mailId)
         {
-            QueryResult* resultItems = CharacterDatabase.PQuery("SELECT item_guid,item_template FROM mail_items WHERE mail_id='%u'", m->messageID);
-            if (resultItems)
-            {
-                do
-                {
-                    Field* fields2 = resultItems->Fetch();
+            delMails.push_back(row->mailId);
+            if (row->itemTextId)
+                delItemTexts.push_back(row->itemTextId);
+        }
+    }
 
-                    uint32 item_guid_low = fields2[0].GetUInt32();
-                    uint32 item_template = fields2[1].GetUInt32();
+    lastMailId = lastCompleteMailId;
 
-                    m->AddItem(item_guid_low, item_template);
-                }
-                while (resultItems->NextRow());
+    CharacterDatabase.BeginTransaction();
 
-                delete resultItems;
-            }
-            // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
-            if (m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
-            {
-                // mail open and then not returned
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
-                    CharacterDatabase.PExecute("DELETE FROM item_instance WHERE guid = '%u'", itr2->item_guid);
-            }
-            else
-            {
-                // mail will be returned:
-                CharacterDatabase.PExecute("UPDATE mail SET sender = '%u', receiver = '%u', expire_time = '" UI64FMTD "', deliver_time = '" UI64FMTD "',cod = '0', checked = '%u' WHERE id = '%u'",
-                                           m->receiverGuid.GetCounter(), m->sender, (uint64)(basetime + 30 * DAY), (uint64)basetime, MAIL_CHECK_MASK_RETURNED, m->messageID);
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
-                {
-                    // update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
-                    CharacterDatabase.PExecute("UPDATE mail_items SET receiver = %u WHERE item_guid = '%u'", m->sender, itr2->item_guid);
-                    CharacterDatabase.PExecute("UPDATE item_instance SET owner_guid = %u WHERE guid = '%u'", m->sender, itr2->item_guid);
-                }
-                delete m;
-                continue;
-            }
-        }
+    for (std::map<std::pair<uint32, uint32>, ReturnedMails>::const_iterator itr = returnedMails.begin(); itr != returnedMails.end(); ++itr)
+    {
+        uint32 sender = itr->first.first;
+        uint32 receiver = itr->first.second;
 
-        if (m->itemTextId)
-            CharacterDatabase.PExecute("DELETE FROM item_text WHERE id = '%u'", m->itemTextId);
+        // mail will be returned:
+        std::ostringstream ss;
+        ss << "UPDATE mail SET sender = '" << receiver << "', receiver = '" << sender << "', expire_time = '" << uint64(basetime + 30 * DAY)
+           << "', deliver_time = '" << uint64(basetime) << "', cod = '0', checked = '" << uint32(MAIL_CHECK_MASK_RETURNED) << "' WHERE id IN";
+        ExecuteForIdList(ss.str().c_str(), itr->second.mails);
 
-        // deletemail = true;
-        // delmails << m->messageID << ", ";
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE id = '%u'", m->messageID);
-        delete m;
-        ++count;
+        // update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
+        ss.str("");
+        ss << "UPDATE mail_items SET receiver = '" << sender << "' WHERE mail_id IN";
+        ExecuteForIdList(ss.str().c_str(), itr->second.mails);
+
+        ss.str("");
+        ss << "UPDATE item_instance SET owner_guid = '" << sender << "' WHERE guid IN";
+        ExecuteForIdList(ss.str().c_str(), itr->second.items);
+    }
+
+    ExecuteForIdList("DELETE FROM item_instance WHERE guid IN", delItems);
+    ExecuteForIdList("DELETE FROM mail_items WHERE mail_id IN", delMails);
+    ExecuteForIdList("DELETE FROM item_text WHERE id IN", delItemTexts);
+    ExecuteForIdList("DELETE FROM mail WHERE id IN", delMails);
+
+    CharacterDatabase.CommitTransaction();
+
+    count += delMails.size();
+    return hasMore;
+}
+
+/// @param serverUp true if the server is already running, false when the server is started
+void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
+{
+    time_t basetime = time(nullptr);
+    DEBUG_LOG("Returning mails current time: hour: %d, minute: %d, second: %d ", localtime(&basetime)->tm_hour, localtime(&basetime)->tm_min, localtime(&basetime)->tm_sec);
+
+    if (serverUp)
+    {
+        // the previous run is still streaming its chunks (can happen only after a huge mass mail)
+        if (m_oldMailsJobRunning)
+            return;
+
+        m_oldMailsJobRunning = true;
+        m_oldMailsJobCount = 0;
+        CharacterDatabase.AsyncPQuery(this, &ObjectMgr::ReturnOrDeleteOldMailsCallback, uint64(basetime), uint32(0), OLD_MAILS_CHUNK_QUERY, uint64(basetime), 0, OLD_MAILS_CHUNK_SIZE);
+        return;
+    }
+
+    // delete all old mails without item and without body immediately, if starting server
+    CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND itemTextId = 0", (uint64)basetime);
+
+    BarGoLink bar(1);
+    bar.step();
+
+    uint32 count = 0;
+    uint32 lastMailId = 0;
+    while (QueryResult* result = CharacterDatabase.PQuery(OLD_MAILS_CHUNK_QUERY, uint64(basetime), lastMailId, OLD_MAILS_CHUNK_SIZE))
+    {
+        bool hasMore = ReturnOrDeleteOldMailsChunk(result, basetime, false, lastMailId, count);
+        delete result;
+        if (!hasMore)
+            break;
     }
-    while (result->NextRow());
-    delete result;
 
     sLog.outString(">> Loaded %u mails", count);
     sLog.outString();
 }
 
+void ObjectMgr::ReturnOrDeleteOldMailsCallback(QueryResult* result, uint64 basetime, uint32 lastMailId)
+{
+    bool hasMore = false;
+    if (result)
+    {
+        hasMore = ReturnOrDeleteOldMailsChunk(result, time_t(basetime), true, lastMailId, m_oldMailsJobCount);
+        delete result;
+    }
+
+    if (hasMore)
+    {
+        CharacterDatabase.AsyncPQuery(this, &ObjectMgr::ReturnOrDeleteOldMailsCallback, basetime, lastMailId, OLD_MAILS_CHUNK_QUERY, basetime, lastMailId, OLD_MAILS_CHUNK_SIZE);
+        return;
+    }
+
+    DETAIL_LOG("Returning old mails finished, %u mails deleted", m_oldMailsJobCount);
+    m_oldMailsJobRunning = false;
+}
+
 void ObjectMgr::LoadQuestAreaTriggers()
 {
     mQuestAreaTriggerMap.clear();                           // need for reload case
@@ -764,6 +764,7 @@ class ObjectMgr
             return itr != mFishingBaseForArea.end() ? itr->second : 0;
         }
 
+        // at server start the expired mails are processed at once, later they are streamed in chunks by async queries
         void ReturnOrDeleteOldMails(bool serverUp);
 
         void SetHighestGuids();
@@ -1212,6 +1213,12 @@ class ObjectMgr
         void LoadGossipMenu(std::set<uint32>& gossipScriptSet);
         void LoadGossipMenuItems(std::set<uint32>& gossipScriptSet);
 
+        void ReturnOrDeleteOldMailsCallback(QueryResult* result, uint64 basetime, uint32 lastMailId);
+        bool ReturnOrDeleteOldMailsChunk(QueryResult* result, time_t basetime, bool serverUp, uint32& lastMailId, uint32& count);
+
+        bool m_oldMailsJobRunning;                          // an async chunk query of expired mails is pending
+        uint32 m_oldMailsJobCount;                          // mails deleted by the running job
+
         MailLevelRewardMap m_mailLevelRewardMap;
 
         typedef std::map<uint32, PetLevelInfo*> PetLevelInfoMap;
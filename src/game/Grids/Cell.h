@@ -117,6 +117,10 @@ struct Cell
         template<class T> static void VisitWorldObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
         template<class T> static void VisitAllObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
 
+        // calls visitor.VisitUnit() for the players and creatures of the cells within radius whose 2d distance to (x, y)
+        // is less than radius + objectRadius + their bounding radius, using the packed cell positions instead of the object lists
+        template<class T> static void VisitUnitsInRange(float x, float y, Map* map, T& visitor, float radius, float objectRadius = 0.0f, bool dont_load = true);
+
     private:
         template<class T, class CONTAINER> void VisitCircle(TypeContainerVisitor<T, CONTAINER>&, Map&, const CellPair&, const CellPair&) const;
 };
@@ -241,4 +241,15 @@ inline void Cell::VisitAllObjects(float x, float y, Map* map, T& visitor, float
     cell.Visit(p, wnotifier, *map, x, y, radius);
 }
 
+template<class T>
+inline void Cell::VisitUnitsInRange(float x, float y, Map* map, T& visitor, float radius, float objectRadius, bool dont_load)
+{
+    // candidates of all cells are collected before the visitor runs
+    std::vector<Unit*> units;
+    CellPositionIndex::FindUnitsInRange(map, x, y, radius, objectRadius, dont_load, units);
+
+    for (Unit* unit : units)
+        visitor.VisitUnit(unit);
+}
+
 #endif
@@ -123,6 +123,21 @@ void MessageDelivererExcept::Visit(CameraMapType& m)
     }
 }
 
+void MessagesDelivererExcept::Visit(CameraMapType& m)
+{
+    for (CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Player* owner = iter->getSource()->GetOwner();
+
+        if (owner == i_skipped_receiver)
+            continue;
+
+        if (WorldSession* session = owner->GetSession())
+            for (std::vector<WorldPacket>::const_iterator msg = i_messages.begin(); msg != i_messages.end(); ++msg)
+                session->SendPacket(*msg);
+    }
+}
+
 void ObjectMessageDeliverer::Visit(CameraMapType& m)
 {
     for (CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -170,6 +185,27 @@ void ObjectUpdater::Visit(GridRefManager<T>& m)
     }
 }
 
+void ObjectUpdater::Visit(GameObjectMapType& m)
+{
+    for (GameObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        GameObject* go = iter->getSource();
+        WorldObject::UpdateHelper helper(go);
+
+        // traps must react at once, other objects far from players only count down their timers
+        if (i_idleInterval && go->GetGoType() != GAMEOBJECT_TYPE_TRAP && !go->isActiveObject())
+        {
+            uint32 elapsed = helper.GetTimeElapsed();
+            if (elapsed < i_idleInterval)
+                continue;
+
+            helper.Update(std::min(elapsed, i_idleInterval + i_timeDiff));
+        }
+        else
+            helper.Update(i_timeDiff);
+    }
+}
+
 bool CannibalizeObjectCheck::operator()(Corpse* u)
 {
     // ignore bones
@@ -254,5 +290,4 @@ bool MaNGOS::AnyAssistCreatureInRangeCheck::operator()(Creature* u)
     return true;
 }
 
-template void ObjectUpdater::Visit<GameObject>(GameObjectMapType&);
 template void ObjectUpdater::Visit<DynamicObject>(DynamicObjectMapType&);
@@ -76,6 +76,18 @@ namespace MaNGOS
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
 
+    struct MessagesDelivererExcept
+    {
+        std::vector<WorldPacket> const& i_messages;
+        Player const* i_skipped_receiver;
+
+        MessagesDelivererExcept(std::vector<WorldPacket> const& msgs, Player const* skipped)
+            : i_messages(msgs), i_skipped_receiver(skipped) {}
+
+        void Visit(CameraMapType& m);
+        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+    };
+
     struct ObjectMessageDeliverer
     {
         WorldPacket const& i_message;
@@ -111,12 +123,14 @@ namespace MaNGOS
     struct ObjectUpdater
     {
         uint32 i_timeDiff;
-        explicit ObjectUpdater(const uint32& diff) : i_timeDiff(diff) {}
+        uint32 i_idleInterval;                              // idle objects are skipped until updated this long ago, 0 to update all
+        explicit ObjectUpdater(const uint32& diff) : i_timeDiff(diff), i_idleInterval(0) {}
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(PlayerMapType&) {}
         void Visit(CorpseMapType&) {}
         void Visit(CameraMapType&) {}
         void Visit(CreatureMapType&);
+        void Visit(GameObjectMapType&);
     };
 
     struct PlayerRelocationNotifier
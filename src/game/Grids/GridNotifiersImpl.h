@@ -44,8 +44,20 @@ inline void MaNGOS::ObjectUpdater::Visit(CreatureMapType& m)
 {
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        WorldObject::UpdateHelper helper(iter->getSource());
-        helper.Update(i_timeDiff);
+        Creature* creature = iter->getSource();
+        WorldObject::UpdateHelper helper(creature);
+
+        // idle creatures far from players are updated at reduced rate, the skipped time is added to the next update
+        if (i_idleInterval && !creature->isInCombat() && !creature->IsInEvadeMode() && !creature->isActiveObject() && !creature->HasCharmer())
+        {
+            uint32 elapsed = helper.GetTimeElapsed();
+            if (elapsed < i_idleInterval)
+                continue;
+
+            helper.Update(std::min(elapsed, i_idleInterval + i_timeDiff));
+        }
+        else
+            helper.Update(i_timeDiff);
     }
 }
 
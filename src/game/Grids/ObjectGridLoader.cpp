@@ -94,15 +94,16 @@ class ObjectWorldLoader
         uint32 i_corpses;
 };
 
-template<class T> void addUnitState(T* /*obj*/, CellPair const& /*cell_pair*/)
+template<class T> void addUnitState(T* /*obj*/, CellPair const& /*cell_pair*/, Map* /*map*/)
 {
 }
 
-template<> void addUnitState(Creature* obj, CellPair const& cell_pair)
+template<> void addUnitState(Creature* obj, CellPair const& cell_pair, Map* map)
 {
     Cell cell(cell_pair);
 
     obj->SetCurrentCell(cell);
+    map->GetCellPositions(cell).Insert(obj);
 }
 
 template <class T>
@@ -124,7 +125,7 @@ void LoadHelper(CellGuidSet const& guid_set, CellPair& cell, GridRefManager<T>&
 
         grid.AddGridObject(obj);
 
-        addUnitState(obj, cell);
+        addUnitState(obj, cell, map);
         obj->SetMap(map);
         obj->AddToWorld();
         if (obj->isActiveObject())
@@ -157,7 +158,7 @@ void LoadHelper(CellCorpseSet const& cell_corpses, CellPair& cell, CorpseMapType
 
         grid.AddWorldObject(obj);
 
-        addUnitState(obj, cell);
+        addUnitState(obj, cell, map);
         obj->SetMap(map);
         obj->AddToWorld();
         if (obj->isActiveObject())
@@ -90,6 +90,7 @@ enum GroupUpdateFlags
     GROUP_UPDATE_FLAG_PET_MAX_POWER     = 0x00020000,       // uint16 pet max power
     GROUP_UPDATE_FLAG_PET_AURAS         = 0x00040000,       // uint64 mask, for each bit set uint16 spellid + uint8 unk, pet auras...
     GROUP_UPDATE_PET                    = 0x0007FC00,       // all pet flags
+    GROUP_UPDATE_HEALTH_POWER           = 0x00012012,       // current health and power of player and pet, sent once per Group.HealthUpdateInterval
     GROUP_UPDATE_FULL                   = 0x0007FFFF,       // all known flags
 };
 
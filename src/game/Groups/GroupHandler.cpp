@@ -344,7 +344,7 @@ void WorldSession::HandleGroupUninviteOpcode(WorldPacket& recv_data)
 
     if (ObjectGuid guid = grp->GetMemberGuid(membername))
     {
-        Player::RemoveFromGro up(grp, guid);
+        Player::RemoveFromGroup(grp, guid);
         return;
     }
 
@@ -306,7 +306,7 @@ class Guild
 
         uint32 GetId() const { return m_Id; }
         ObjectGuid GetLeaderGuid() const { return m_LeaderGuid; }
-　        std::string const& GetName() const { return m_Name; }
+        std::string const& GetName() const { return m_Name; }
         std::string const& GetMOTD() const { return MOTD; }
         std::string const& GetGINFO() const { return GINFO; }
 
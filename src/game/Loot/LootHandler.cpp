@@ -202,7 +202,7 @@ void WorldSession::HandleLootMethodOpcode(WorldPacket& recv_data)
     uint32 lootThreshold;
     recv_data >> lootMethod >> lootMaster >> lootThreshold;
 
-��   //��ȡ���������
+    //��ȡ���������
     Group* group = GetPlayer()->GetGroup();
     if (!group)
         return;
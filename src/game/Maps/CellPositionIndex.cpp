@@ -0,0 +1,127 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/CellPositionIndex.h"
+#include "Entities/Object.h"
+#include "Entities/Unit.h"
+#include "Grids/CellImpl.h"
+
+// distances are computed for blocks of this many objects before any of them is collected
+#define CELL_POSITION_FILTER_BLOCK 64
+
+void CellPositionIndex::Insert(WorldObject* obj)
+{
+    Remove(obj);
+
+    obj->m_cellPositionIndex = this;
+    obj->m_cellPositionSlot = uint32(m_objects.size());
+
+    m_x.push_back(obj->GetPositionX());
+    m_y.push_back(obj->GetPositionY());
+    m_radius.push_back(obj->GetObjectBoundingRadius());
+    m_typeMask.push_back(obj->GetTypeMask());
+    m_objects.push_back(obj);
+}
+
+void CellPositionIndex::Remove(WorldObject* obj)
+{
+    CellPositionIndex* index = obj->m_cellPositionIndex;
+    if (!index)
+        return;
+
+    // the last entry takes the place of the removed one
+    uint32 slot = obj->m_cellPositionSlot;
+    uint32 last = uint32(index->m_objects.size()) - 1;
+    if (slot != last)
+    {
+        index->m_x[slot] = index->m_x[last];
+        index->m_y[slot] = index->m_y[last];
+        index->m_radius[slot] = index->m_radius[last];
+        index->m_typeMask[slot] = index->m_typeMask[last];
+        index->m_objects[slot] = index->m_objects[last];
+        index->m_objects[slot]->m_cellPositionSlot = slot;
+    }
+
+    index->m_x.pop_back();
+    index->m_y.pop_back();
+    index->m_radius.pop_back();
+    index->m_typeMask.pop_back();
+    index->m_objects.pop_back();
+
+    obj->m_cellPositionIndex = nullptr;
+    obj->m_cellPositionSlot = 0;
+}
+
+void CellPositionIndex::FilterInRange(float x, float y, float range, uint16 typeMask, std::vector<WorldObject*>& objects) const
+{
+    float const* posX = m_x.data();
+    float const* posY = m_y.data();
+    float const* radius = m_radius.data();
+    uint16 const* mask = m_typeMask.data();
+
+    uint8 matches[CELL_POSITION_FILTER_BLOCK];
+    size_t count = m_objects.size();
+    for (size_t begin = 0; begin < count; begin += CELL_POSITION_FILTER_BLOCK)
+    {
+        size_t blockSize = std::min(count - begin, size_t(CELL_POSITION_FILTER_BLOCK));
+
+        // no branches in this loop, so the compiler can vectorize it
+        for (size_t i = 0; i < blockSize; ++i)
+        {
+            float dx = posX[begin + i] - x;
+            float dy = posY[begin + i] - y;
+            float maxDist = range + radius[begin + i];
+            matches[i] = uint8(dx * dx + dy * dy < maxDist * maxDist) & uint8((mask[begin + i] & typeMask) != 0);
+        }
+
+        for (size_t i = 0; i < blockSize; ++i)
+            if (matches[i])
+                objects.push_back(m_objects[begin + i]);
+    }
+}
+
+void CellPositionIndex::FindUnitsInRange(Map* map, float x, float y, float radius, float objectRadius, bool dont_load, std::vector<Unit*>& units)
+{
+    CellPair standing_cell(MaNGOS::ComputeCellPair(x, y));
+    if (standing_cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || standing_cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+        return;
+
+    // same search limit as Cell::Visit()
+    if (radius > 333.0f)
+        radius = 333.0f;
+
+    CellArea area = Cell::CalculateCellArea(x, y, radius);
+
+    std::vector<WorldObject*> objects;
+    for (uint32 i = area.low_bound.x_coord; i <= area.high_bound.x_coord; ++i)
+    {
+        for (uint32 j = area.low_bound.y_coord; j <= area.high_bound.y_coord; ++j)
+        {
+            Cell cell(CellPair(i, j));
+            if (dont_load)
+                cell.SetNoCreate();
+
+            if (CellPositionIndex const* positions = map->GetVisitableCellPositions(cell))
+                positions->FilterInRange(x, y, radius + objectRadius, TYPEMASK_UNIT, objects);
+        }
+    }
+
+    units.reserve(units.size() + objects.size());
+    for (WorldObject* obj : objects)
+        units.push_back(static_cast<Unit*>(obj));
+}
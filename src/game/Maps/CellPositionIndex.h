@@ -0,0 +1,58 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_CELL_POSITION_INDEX_H
+#define MANGOS_CELL_POSITION_INDEX_H
+
+#include "Common.h"
+
+class WorldObject;
+class Unit;
+class Map;
+
+/// Packed positions of the players and creatures of one grid cell
+/// Kept in sync with the cell object lists (Map::AddToGrid/RemoveFromGrid) and with every WorldObject::Relocate,
+/// so range searches can drop far away units with a linear scan before touching the objects themselves
+class CellPositionIndex
+{
+    public:
+        // moves the object from the index it is currently in (if any) to this one
+        void Insert(WorldObject* obj);
+        // removes the object from the index it is in, does nothing if it isn't indexed
+        static void Remove(WorldObject* obj);
+
+        void Relocate(uint32 slot, float x, float y) { m_x[slot] = x; m_y[slot] = y; }
+        void SetBoundingRadius(uint32 slot, float radius) { m_radius[slot] = radius; }
+
+        bool empty() const { return m_objects.empty(); }
+
+        // appends the objects matching typeMask whose 2d distance to (x, y) is less than range plus their bounding radius
+        void FilterInRange(float x, float y, float range, uint16 typeMask, std::vector<WorldObject*>& objects) const;
+
+        // appends the players and creatures of the cells within radius passing FilterInRange with range radius + objectRadius
+        static void FindUnitsInRange(Map* map, float x, float y, float radius, float objectRadius, bool dont_load, std::vector<Unit*>& units);
+
+    private:
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_radius;
+        std::vector<uint16> m_typeMask;
+        std::vector<WorldObject*> m_objects;
+};
+
+#endif
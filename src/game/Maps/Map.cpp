@@ -32,8 +32,10 @@
 #include "MapRefManager.h"
 #include "Server/DBCEnums.h"
 #include "Maps/MapPersistentStateMgr.h"
+#include "Pools/PoolManager.h"
 #include "VMapFactory.h"
 #include "MotionGenerators/MoveMap.h"
+#include "MotionGenerators/MovementGenerator.h"
 #include "Chat/Chat.h"
 #include "Weather/Weather.h"
 #include "Grids/ObjectGridLoader.h"
@@ -83,11 +85,11 @@ void Map::LoadMapAndVMap(int gx, int gy)
 }
 
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
-    : i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode),
+    : m_tickTimings(MAP_PHASE_COUNT), m_hasSpawnWork(false), i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode),
       i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0),
-      m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(nullptr),
+      m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_updateLodDistance(0.0f), m_persistentState(nullptr),
       m_activeNonPlayersIter(m_activeNonPlayers.end()), m_onEventNotifiedIter(m_onEventNotifiedObjects.end()),
-      i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
+      i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)), m_activeCellsChanged(false),
       i_data(nullptr), i_script_id(0)
 {
     m_CreatureGuids.Set(sObjectMgr.GetFirstTemporaryCreatureLowGuid());
@@ -100,6 +102,7 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
             // z code
             m_bLoadedGrids[idx][j] = false;
             setNGrid(nullptr, idx, j);
+            m_cellPositions[idx][j] = nullptr;
         }
     }
 
@@ -119,6 +122,7 @@ void Map::InitVisibilityDistance()
 {
     // init visibility for continents
     m_VisibleDistance = World::GetMaxVisibleDistanceOnContinents();
+    m_updateLodDistance = sWorld.getConfig(CONFIG_FLOAT_UPDATE_LOD_DISTANCE_CONTINENTS);
 }
 
 // Template specialization of utility methods
@@ -132,6 +136,7 @@ template<>
 void Map::AddToGrid(Player* obj, NGridType* grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).AddWorldObject(obj);
+    GetCellPositions(cell).Insert(obj);
 }
 
 template<>
@@ -164,6 +169,8 @@ void Map::AddToGrid(Creature* obj, NGridType* grid, Cell const& cell)
         (*grid)(cell.CellX(), cell.CellY()).AddGridObject<Creature>(obj);
         obj->SetCurrentCell(cell);
     }
+
+    GetCellPositions(cell).Insert(obj);
 }
 
 template<class T>
@@ -176,6 +183,7 @@ template<>
 void Map::RemoveFromGrid(Player* obj, NGridType* grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).RemoveWorldObject(obj);
+    CellPositionIndex::Remove(obj);
 }
 
 template<>
@@ -206,6 +214,8 @@ void Map::RemoveFromGrid(Creature* obj, NGridType* grid, Cell const& cell)
     {
         (*grid)(cell.CellX(), cell.CellY()).RemoveGridObject<Creature>(obj);
     }
+
+    CellPositionIndex::Remove(obj);
 }
 
 void Map::DeleteFromWorld(Player* pl)
@@ -221,6 +231,7 @@ Map::EnsureGridCreated(const GridPair& p)
     {
         setNGrid(new NGridType(p.x_coord * MAX_NUMBER_OF_GRIDS + p.y_coord, p.x_coord, p.y_coord, i_gridExpiry, sWorld.getConfig(CONFIG_BOOL_GRID_UNLOAD)),
                  p.x_coord, p.y_coord);
+        m_cellPositions[p.x_coord][p.y_coord] = new CellPositionIndex[MAX_NUMBER_OF_CELLS * MAX_NUMBER_OF_CELLS];
 
         // build a linkage between this map and NGridType
         buildNGridLinkage(getNGrid(p.x_coord, p.y_coord));
@@ -317,6 +328,7 @@ bool Map::Add(Player* player)
     NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
     player->GetViewPoint().Event_AddedToWorld(&(*grid)(cell.CellX(), cell.CellY()));
     UpdateObjectVisibility(player, cell, p);
+    UpdateActiveCellSource(player);
 
     if (i_data)
         i_data->OnPlayerEnter(player);
@@ -406,6 +418,27 @@ void Map::MessageBroadcast(WorldObject const* obj, WorldPacket const& msg)
     cell.Visit(p, message, *this, *obj, GetVisibilityDistance());
 }
 
+void Map::MessageBroadcast(WorldObject const* obj, std::vector<WorldPacket> const& msgs, Player const* skipped_receiver)
+{
+    CellPair p = MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
+
+    if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+    {
+        sLog.outError("Map::MessageBroadcast: Object (GUID: %u TypeId: %u) have invalid coordinates X:%f Y:%f grid cell [%u:%u]", obj->GetGUIDLow(), obj->GetTypeId(), obj->GetPositionX(), obj->GetPositionY(), p.x_coord, p.y_coord);
+        return;
+    }
+
+    Cell cell(p);
+    cell.SetNoCreate();
+
+    if (!loaded(GridPair(cell.data.Part.grid_x, cell.data.Part.grid_y)))
+        return;
+
+    MaNGOS::MessagesDelivererExcept post_man(msgs, skipped_receiver);
+    TypeContainerVisitor<MaNGOS::MessagesDelivererExcept, WorldTypeMapContainer > message(post_man);
+    cell.Visit(p, message, *this, *obj, GetVisibilityDistance());
+}
+
 void Map::MessageDistBroadcast(Player const* player, WorldPacket const& msg, float dist, bool to_self, bool own_team_only)
 {
     CellPair p = MaNGOS::ComputeCellPair(player->GetPositionX(), player->GetPositionY());
@@ -520,127 +553,114 @@ bool Map::loaded(const GridPair& p) const
     return (getNGrid(p.x_coord, p.y_coord) && isGridObjectDataLoaded(p.x_coord, p.y_coord));
 }
 
+CellPositionIndex const* Map::GetVisitableCellPositions(Cell const& cell)
+{
+    if (cell.NoCreate() && !loaded(cell.gridPair()))
+        return nullptr;
+
+    EnsureGridLoaded(cell);
+    return &GetCellPositions(cell);
+}
+
 void Map::Update(const uint32& t_diff)
 {
     m_dyn_tree.update(t_diff);
 
     /// update worldsessions for existing players
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* plr = m_mapRefIter->getSource();
-        if (plr && plr->IsInWorld())
+        TickPhaseTimer phaseTimer(m_tickTimings, MAP_PHASE_SESSIONS);
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            WorldSession* pSession = plr->GetSession();
-            MapSessionFilter updater(pSession);
+            Player* plr = m_mapRefIter->getSource();
+            if (plr && plr->IsInWorld())
+            {
+                WorldSession* pSession = plr->GetSession();
+                MapSessionFilter updater(pSession);
 
-            pSession->Update(updater);
+                pSession->Update(updater);
+            }
         }
     }
 
     /// update players at tick
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* plr = m_mapRefIter->getSource();
-        if (plr && plr->IsInWorld())
+        TickPhaseTimer phaseTimer(m_tickTimings, MAP_PHASE_PLAYERS);
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            WorldObject::UpdateHelper helper(plr);
-            helper.Update(t_diff);
+            Player* plr = m_mapRefIter->getSource();
+            if (plr && plr->IsInWorld())
+            {
+                WorldObject::UpdateHelper helper(plr);
+                helper.Update(t_diff);
+            }
         }
     }
 
     /// update active cells around players and active objects
-    resetMarkedCells();
-
     {
-        std::lock_guard<std::mutex> guard(m_messageMutex);
-        for (auto& message : m_messageVector)
-            message(this);
+        TickPhaseTimer phaseTimer(m_tickTimings, MAP_PHASE_CELLS);
 
-        m_messageVector.clear();
-    }
+        {
+            std::lock_guard<std::mutex> guard(m_messageMutex);
+            for (auto& message : m_messageVector)
+                message(this);
 
-    MaNGOS::ObjectUpdater obj_updater(t_diff);
-    TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(obj_updater);    // For creature
-    TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(obj_updater);   // For pets
+            m_messageVector.clear();
+        }
 
-    // the player iterator is stored in the map object
-    // to make sure calls to Map::Remove don't invalidate it
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
-    {
-        Player* plr = m_mapRefIter->getSource();
+        // the list is only rebuilt here, cells activated during the object updates wait for next update
+        if (m_activeCellsChanged)
+        {
+            m_activeCellList.clear();
+            m_activeCellList.reserve(m_activeCells.size());
+            for (auto const& itr : m_activeCells)
+                m_activeCellList.push_back(std::make_pair(itr.first, itr.second.nearSources > 0));
 
-        if (!plr->IsInWorld() || !plr->IsPositionValid())
-            continue;
+            std::sort(m_activeCellList.begin(), m_activeCellList.end());
+            m_activeCellsChanged = false;
+        }
 
-        // lets update mobs/objects in ALL visible cells around player!
-        CellArea area = Cell::CalculateCellArea(plr->GetPositionX(), plr->GetPositionY(), GetVisibilityDistance());
+        MaNGOS::ObjectUpdater obj_updater(t_diff);
+        TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(obj_updater);    // For creature
+        TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(obj_updater);   // For pets
 
-        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+        // idle objects in cells outside the update LOD distance of all sources are updated once per interval
+        uint32 lodInterval = sWorld.getConfig(CONFIG_UINT32_UPDATE_LOD_INTERVAL);
+
+        // lets update mobs/objects in ALL visible cells around players and active objects!
+        for (auto const& activeCell : m_activeCellList)
         {
-            for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
-            {
-                // marked cells are those that have been visited
-                // don't visit the same cell twice
-                uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                if (!isCellMarked(cell_id))
-                {
-                    markCell(cell_id);
-                    CellPair pair(x, y);
-                    Cell cell(pair);
-                    cell.SetNoCreate();
-                    Visit(cell, grid_object_update);
-                    Visit(cell, world_object_update);
-                }
-            }
+            obj_updater.i_idleInterval = activeCell.second ? 0 : lodInterval;
+
+            CellPair pair(activeCell.first % TOTAL_NUMBER_OF_CELLS_PER_MAP, activeCell.first / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+            Cell cell(pair);
+            cell.SetNoCreate();
+            Visit(cell, grid_object_update);
+            Visit(cell, world_object_update);
         }
     }
 
-    // non-player active objects
-    if (!m_activeNonPlayers.empty())
+    // recalculate paths of chasing/following units that requested it during the object updates
+    if (!m_repathRequests.empty())
     {
-        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
-        {
-            // skip not in world
-            WorldObject* obj = *m_activeNonPlayersIter;
-
-            // step before processing, in this case if Map::Remove remove next object we correctly
-            // step to next-next, and if we step to end() then newly added objects can wait next update.
-            ++m_activeNonPlayersIter;
-
-            if (!obj->IsInWorld() || !obj->IsPositionValid())
-                continue;
+        TickPhaseTimer phaseTimer(m_tickTimings, MAP_PHASE_REPATH);
+        ProcessRepathRequests();
+    }
 
-            // lets update mobs/objects in ALL visible cells around player!
-            CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
+    // Send periodic aura logs, world objects and item update field changes
+    {
+        TickPhaseTimer phaseTimer(m_tickTimings, MAP_PHASE_OBJECT_UPDATES);
+        if (!m_periodicAuraLogs.empty())
+            SendPeriodicAuraLogs();
 
-            for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
-            {
-                for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
-                {
-                    // marked cells are those that have been visited
-                    // don't visit the same cell twice
-                    uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                    if (!isCellMarked(cell_id))
-                    {
-                        markCell(cell_id);
-                        CellPair pair(x, y);
-                        Cell cell(pair);
-                        cell.SetNoCreate();
-                        Visit(cell, grid_object_update);
-                        Visit(cell, world_object_update);
-                    }
-                }
-            }
-        }
+        SendObjectUpdates();
     }
 
-    // Send world objects and item update field changes
-    SendObjectUpdates();
-
     // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
     if (!IsBattleGroundOrArena())
     {
+        TickPhaseTimer phaseTimer(m_tickTimings, MAP_PHASE_GRIDS);
         for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
         {
             NGridType* grid = i->getSource();
@@ -653,10 +673,23 @@ void Map::Update(const uint32& t_diff)
 
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
+    {
+        TickPhaseTimer phaseTimer(m_tickTimings, MAP_PHASE_SCRIPTS);
         ScriptsProcess();
+    }
 
     if (i_data)
+    {
+        TickPhaseTimer phaseTimer(m_tickTimings, MAP_PHASE_INSTANCE);
         i_data->Update(t_diff);
+    }
+
+    ///- Apply game event spawn changes
+    if (m_hasSpawnWork)
+    {
+        TickPhaseTimer phaseTimer(m_tickTimings, MAP_PHASE_SPAWNS);
+        ProcessSpawnWork();
+    }
 
     m_weatherSystem->UpdateWeathers(t_diff);
 }
@@ -679,6 +712,7 @@ void Map::Remove(Player* player, bool remove)
     if (m_mapRefIter == player->GetMapRef())
         m_mapRefIter = m_mapRefIter->nocheck_prev();
     player->GetMapRef().unlink();
+    RemoveActiveCellSource(player);
     CellPair p = MaNGOS::ComputeCellPair(player->GetPositionX(), player->GetPositionY());
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
     {
@@ -785,6 +819,7 @@ Map::PlayerRelocation(Player* player, float x, float y, float z, float orientati
     }
 
     player->OnRelocated();
+    UpdateActiveCellSource(player);
 
     NGridType* newGrid = getNGrid(new_cell.GridX(), new_cell.GridY());
     if (!same_cell && newGrid->GetGridState() != GRID_STATE_ACTIVE)
@@ -804,6 +839,8 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
         // update pos
         creature->Relocate(x, y, z, ang);
         creature->OnRelocated();
+        if (creature->isActiveObject())
+            UpdateActiveCellSource(creature);
     }
     // if creature can't be move in new cell/grid (not loaded) move it to repawn cell/grid
     // creature coordinates will be updated and notifiers send
@@ -889,6 +926,10 @@ bool Map::UnloadGrid(const uint32& x, const uint32& y, bool pForce)
         unloader.UnloadN();
         delete getNGrid(x, y);
         setNGrid(nullptr, x, y);
+
+        // all units of the grid are deleted or moved away by now
+        delete[] m_cellPositions[x][y];
+        m_cellPositions[x][y] = nullptr;
     }
 
     int gx = (MAX_NUMBER_OF_GRIDS - 1) - x;
@@ -1160,11 +1201,108 @@ bool Map::ActiveObjectsNearGrid(uint32 x, uint32 y) const
     return false;
 }
 
+Map::ActiveCellSource Map::CalculateActiveCellSource(WorldObject const* obj) const
+{
+    ActiveCellSource source;
+    source.area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
+
+    if (m_updateLodDistance > 0.0f && m_updateLodDistance < GetVisibilityDistance())
+        source.nearArea = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), m_updateLodDistance);
+    else
+        source.nearArea = source.area;
+
+    return source;
+}
+
+void Map::UpdateActiveCellSource(WorldObject const* obj)
+{
+    if (!obj->IsPositionValid())
+        return;
+
+    ActiveCellSource source = CalculateActiveCellSource(obj);
+
+    std::pair<ActiveCellSources::iterator, bool> itr = m_activeCellSources.emplace(obj, source);
+    if (!itr.second)
+    {
+        ActiveCellSource& oldSource = itr.first->second;
+        if (oldSource.area.low_bound == source.area.low_bound && oldSource.area.high_bound == source.area.high_bound &&
+                oldSource.nearArea.low_bound == source.nearArea.low_bound && oldSource.nearArea.high_bound == source.nearArea.high_bound)
+            return;
+
+        ChangeActiveCells(oldSource, false);
+        oldSource = source;
+    }
+
+    ChangeActiveCells(source, true);
+}
+
+void Map::RefreshActiveCells()
+{
+    m_activeCells.clear();
+    m_activeCellsChanged = true;
+
+    for (auto& itr : m_activeCellSources)
+    {
+        itr.second = CalculateActiveCellSource(itr.first);
+        ChangeActiveCells(itr.second, true);
+    }
+}
+
+void Map::RemoveActiveCellSource(WorldObject const* obj)
+{
+    ActiveCellSources::iterator itr = m_activeCellSources.find(obj);
+    if (itr == m_activeCellSources.end())
+        return;
+
+    ChangeActiveCells(itr->second, false);
+    m_activeCellSources.erase(itr);
+}
+
+void Map::ChangeActiveCells(ActiveCellSource const& source, bool add)
+{
+    CellArea const& area = source.area;
+    CellArea const& nearArea = source.nearArea;
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            bool isNear = nearArea.low_bound.x_coord <= x && x <= nearArea.high_bound.x_coord &&
+                          nearArea.low_bound.y_coord <= y && y <= nearArea.high_bound.y_coord;
+
+            if (add)
+            {
+                ActiveCellRefs& refs = m_activeCells[cell_id];
+                if (++refs.sources == 1)
+                    m_activeCellsChanged = true;
+                if (isNear && ++refs.nearSources == 1)
+                    m_activeCellsChanged = true;
+            }
+            else
+            {
+                std::unordered_map<uint32, ActiveCellRefs>::iterator itr = m_activeCells.find(cell_id);
+                if (itr == m_activeCells.end())
+                    continue;
+
+                if (isNear && itr->second.nearSources && --itr->second.nearSources == 0)
+                    m_activeCellsChanged = true;
+                if (--itr->second.sources == 0)
+                {
+                    m_activeCells.erase(itr);
+                    m_activeCellsChanged = true;
+                }
+            }
+        }
+    }
+}
+
 void Map::AddToActive(WorldObject* obj)
 {
     m_activeNonPlayers.insert(obj);
     Cell cell = Cell(MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY()));
     EnsureGridLoaded(cell);
+    UpdateActiveCellSource(obj);
 
     // also not allow unloading spawn grid to prevent creating creature clone at load
     if (obj->GetTypeId() == TYPEID_UNIT)
@@ -1201,6 +1339,8 @@ void Map::RemoveFromActive(WorldObject* obj)
     else
         m_activeNonPlayers.erase(obj);
 
+    RemoveActiveCellSource(obj);
+
     // also allow unloading spawn grid
     if (obj->GetTypeId() == TYPEID_UNIT)
     {
@@ -1372,6 +1512,7 @@ void DungeonMap::InitVisibilityDistance()
 {
     // init visibility distance for instances
     m_VisibleDistance = World::GetMaxVisibleDistanceInInstances();
+    m_updateLodDistance = sWorld.getConfig(CONFIG_FLOAT_UPDATE_LOD_DISTANCE_INSTANCES);
 }
 
 /*
@@ -1650,6 +1791,7 @@ void BattleGroundMap::InitVisibilityDistance()
 {
     // init visibility distance for BG/Arenas
     m_VisibleDistance = World::GetMaxVisibleDistanceInBGArenas();
+    m_updateLodDistance = sWorld.getConfig(CONFIG_FLOAT_UPDATE_LOD_DISTANCE_BGARENAS);
 }
 
 bool BattleGroundMap::CanEnter(Player* player)
@@ -1722,14 +1864,18 @@ bool Map::ScriptsStart(ScriptMapMapName const& scripts, uint32 id, Object* sourc
 
     if (execParams)                                         // Check if the execution should be uniquely
     {
-        for (ScriptScheduleMap::const_iterator searchItr = m_scriptSchedule.begin(); searchItr != m_scriptSchedule.end(); ++searchItr)
+        ScriptScheduleIndex::const_iterator scheduled = m_scriptScheduleIndex.find(ScriptKey(scripts.first, id));
+        if (scheduled != m_scriptScheduleIndex.end())
         {
-            if (searchItr->second.IsSameScript(scripts.first, id,
-                                               execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE ? sourceGuid : ObjectGuid(),
-                                               execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET ? targetGuid : ObjectGuid(), ownerGuid))
+            for (ScriptScheduleMap::iterator searchItr : scheduled->second)
             {
-                DEBUG_LOG("DB-SCRIPTS: Process table `%s` id %u. Skip script as script already started for source %s, target %s - ScriptsStartParams %u", scripts.first, id, sourceGuid.GetString().c_str(), targetGuid.GetString().c_str(), execParams);
-                return true;
+                if (searchItr->second.IsSameScript(scripts.first, id,
+                                                   execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE ? sourceGuid : ObjectGuid(),
+                                                   execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET ? targetGuid : ObjectGuid(), ownerGuid))
+                {
+                    DEBUG_LOG("DB-SCRIPTS: Process table `%s` id %u. Skip script as script already started for source %s, target %s - ScriptsStartParams %u", scripts.first, id, sourceGuid.GetString().c_str(), targetGuid.GetString().c_str(), execParams);
+                    return true;
+                }
             }
         }
     }
@@ -1740,9 +1886,7 @@ bool Map::ScriptsStart(ScriptMapMapName const& scripts, uint32 id, Object* sourc
     {
         ScriptAction sa(scripts.first, this, sourceGuid, targetGuid, ownerGuid, &iter->second);
 
-        m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + iter->first), sa));
-
-        sScriptMgr.IncreaseScheduledScriptsCount();
+        ScheduleScriptStep(iter->first, sa);
     }
 
     return true;
@@ -1759,11 +1903,64 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
 
     ScriptAction sa("Internal Activate Command used for spell", this, sourceGuid, targetGuid, ownerGuid, &script);
 
-    m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + delay), sa));
+    ScheduleScriptStep(delay, sa);
+}
+
+void Map::ScheduleScriptStep(uint32 delay, ScriptAction const& action)
+{
+    // delays are in seconds, but counted from the current tick instead of the current second
+    TimePoint time = GetCurrentClockTime() + std::chrono::seconds(delay);
+    ScriptScheduleMap::iterator itr = m_scriptSchedule.insert(ScriptScheduleMap::value_type(time, action));
+    m_scriptScheduleIndex[ScriptKey(action.GetTableName(), action.GetId())].push_back(itr);
 
     sScriptMgr.IncreaseScheduledScriptsCount();
 }
 
+void Map::EraseScriptStep(ScriptScheduleMap::iterator step)
+{
+    ScriptScheduleIndex::iterator scheduled = m_scriptScheduleIndex.find(ScriptKey(step->second.GetTableName(), step->second.GetId()));
+    if (scheduled != m_scriptScheduleIndex.end())
+    {
+        std::vector<ScriptScheduleMap::iterator>& steps = scheduled->second;
+        std::vector<ScriptScheduleMap::iterator>::iterator itr = std::find(steps.begin(), steps.end(), step);
+        if (itr != steps.end())
+        {
+            *itr = steps.back();
+            steps.pop_back();
+        }
+
+        if (steps.empty())
+            m_scriptScheduleIndex.erase(scheduled);
+    }
+
+    m_scriptSchedule.erase(step);
+    sScriptMgr.DecreaseScheduledScriptCount();
+}
+
+void Map::TerminateScript(char const* table, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid)
+{
+    ScriptScheduleIndex::iterator scheduled = m_scriptScheduleIndex.find(ScriptKey(table, id));
+    if (scheduled == m_scriptScheduleIndex.end())
+        return;
+
+    std::vector<ScriptScheduleMap::iterator>& steps = scheduled->second;
+    std::vector<ScriptScheduleMap::iterator>::iterator kept = steps.begin();
+    for (ScriptScheduleMap::iterator step : steps)
+    {
+        if (step->second.IsSameScript(table, id, sourceGuid, targetGuid, ownerGuid))
+        {
+            m_scriptSchedule.erase(step);
+            sScriptMgr.DecreaseScheduledScriptCount();
+        }
+        else
+            *kept++ = step;
+    }
+
+    steps.erase(kept, steps.end());
+    if (steps.empty())
+        m_scriptScheduleIndex.erase(scheduled);
+}
+
 /// Process queued scripts
 void Map::ScriptsProcess()
 {
@@ -1773,34 +1970,17 @@ void Map::ScriptsProcess()
     ///- Process overdue queued scripts
     ScriptScheduleMap::iterator iter = m_scriptSchedule.begin();
     // ok as multimap is a *sorted* associative container
-    while (!m_scriptSchedule.empty() && (iter->first <= sWorld.GetGameTime()))
+    while (!m_scriptSchedule.empty() && (iter->first <= GetCurrentClockTime()))
     {
         if (iter->second.HandleScriptStep())
         {
-            // Terminate following script steps of this script
-            const char* tableName = iter->second.GetTableName();
-            uint32 id = iter->second.GetId();
-            ObjectGuid sourceGuid = iter->second.GetSourceGuid();
-            ObjectGuid targetGuid = iter->second.GetTargetGuid();
-            ObjectGuid ownerGuid = iter->second.GetOwnerGuid();
-
-            for (ScriptScheduleMap::iterator rmItr = m_scriptSchedule.begin(); rmItr != m_scriptSchedule.end();)
-            {
-                if (rmItr->second.IsSameScript(tableName, id, sourceGuid, targetGuid, ownerGuid))
-                {
-                    m_scriptSchedule.erase(rmItr++);
-                    sScriptMgr.DecreaseScheduledScriptCount();
-                }
-                else
-                    ++rmItr;
-            }
+            // Terminate following script steps of this script (this step is one of them)
+            ScriptAction const& action = iter->second;
+            TerminateScript(action.GetTableName(), action.GetId(), action.GetSourceGuid(), action.GetTargetGuid(), action.GetOwnerGuid());
         }
         else
-        {
-            m_scriptSchedule.erase(iter);
+            EraseScriptStep(iter);
 
-            sScriptMgr.DecreaseScheduledScriptCount();
-        }
         iter = m_scriptSchedule.begin();
     }
 }
@@ -1933,6 +2113,118 @@ WorldObject* Map::GetWorldObject(ObjectGuid guid)
     return nullptr;
 }
 
+void Map::RequestRepath(Unit const* unit, float error)
+{
+    RepathRequest& request = m_repathRequests[unit->GetObjectGuid()];
+    if (error > request.error)
+        request.error = error;
+}
+
+// repath priority gain per postponed map update, so that low error requests are not starved
+#define REPATH_AGING_BONUS  1.0f
+
+void Map::ProcessRepathRequests()
+{
+    uint32 budget = sWorld.getConfig(CONFIG_UINT32_PATH_FIND_REPATH_BUDGET);
+
+    std::vector<std::pair<float, ObjectGuid> > queue;
+    queue.reserve(m_repathRequests.size());
+    for (RepathRequestMap::iterator itr = m_repathRequests.begin(); itr != m_repathRequests.end(); ++itr)
+        queue.push_back(std::make_pair(itr->second.error + itr->second.waitTicks * REPATH_AGING_BONUS, itr->first));
+
+    // only the requests with the biggest error fit in this update, the rest waits for the next one
+    if (budget && queue.size() > budget)
+    {
+        std::nth_element(queue.begin(), queue.begin() + budget, queue.end(),
+                         [](std::pair<float, ObjectGuid> const & a, std::pair<float, ObjectGuid> const & b) { return a.first > b.first; });
+        queue.resize(budget);
+
+        for (RepathRequestMap::iterator itr = m_repathRequests.begin(); itr != m_repathRequests.end(); ++itr)
+            ++itr->second.waitTicks;
+    }
+
+    for (std::vector<std::pair<float, ObjectGuid> >::const_iterator itr = queue.begin(); itr != queue.end(); ++itr)
+    {
+        m_repathRequests.erase(itr->second);
+
+        // unit can be already removed from map or have changed its movement since the request
+        Unit* unit = GetUnit(itr->second);
+        if (!unit || !unit->IsInWorld() || unit->GetMotionMaster()->empty())
+            continue;
+
+        unit->GetMotionMaster()->top()->ProcessScheduledRepath(*unit);
+    }
+}
+
+void Map::AddPeriodicAuraLog(Unit const* target, ObjectGuid casterGuid, uint32 spellId, ByteBuffer const& entry)
+{
+    std::vector<PeriodicAuraLog>& logs = m_periodicAuraLogs[target->GetObjectGuid()];
+
+    std::vector<PeriodicAuraLog>::iterator itr = logs.begin();
+    for (; itr != logs.end(); ++itr)
+        if (itr->casterGuid == casterGuid && itr->spellId == spellId)
+            break;
+
+    if (itr == logs.end())
+    {
+        logs.emplace_back(casterGuid, spellId);
+        itr = logs.end() - 1;
+    }
+
+    itr->entries.append(entry);
+    ++itr->count;
+}
+
+void Map::SendPeriodicAuraLogs()
+{
+    std::vector<WorldPacket> packets;
+    for (PeriodicAuraLogMap::const_iterator itr = m_periodicAuraLogs.begin(); itr != m_periodicAuraLogs.end(); ++itr)
+    {
+        // target can be already removed from map since the tick
+        Unit* target = GetUnit(itr->first);
+        if (!target || !target->IsInWorld())
+            continue;
+
+        SendPeriodicAuraLogs(target, itr->second, packets);
+    }
+
+    m_periodicAuraLogs.clear();
+}
+
+void Map::SendPeriodicAuraLogs(Unit* target)
+{
+    PeriodicAuraLogMap::iterator itr = m_periodicAuraLogs.find(target->GetObjectGuid());
+    if (itr == m_periodicAuraLogs.end())
+        return;
+
+    std::vector<WorldPacket> packets;
+    SendPeriodicAuraLogs(target, itr->second, packets);
+    m_periodicAuraLogs.erase(itr);
+}
+
+void Map::SendPeriodicAuraLogs(Unit* target, std::vector<PeriodicAuraLog> const& logs, std::vector<WorldPacket>& packets)
+{
+    packets.clear();
+    packets.reserve(logs.size());
+    for (std::vector<PeriodicAuraLog>::const_iterator log = logs.begin(); log != logs.end(); ++log)
+    {
+        packets.emplace_back(SMSG_PERIODICAURALOG, 30 + log->entries.size());
+        WorldPacket& data = packets.back();
+        data << target->GetPackGUID();
+        data << log->casterGuid.WriteAsPacked();
+        data << uint32(log->spellId);                       // spellId
+        data << uint32(log->count);                         // count
+        data.append(log->entries);
+    }
+
+    // player always gets his own logs, also while his camera is elsewhere
+    Player* player = target->GetTypeId() == TYPEID_PLAYER ? static_cast<Player*>(target) : nullptr;
+    MessageBroadcast(target, packets, player);
+    if (player)
+        for (std::vector<WorldPacket>::const_iterator data = packets.begin(); data != packets.end(); ++data)
+            player->GetSession()->SendPacket(*data);
+}
+
 void Map::SendObjectUpdates()
 {
     UpdateDataMapType update_players;
@@ -2366,6 +2658,89 @@ void Map::AddMessage(std::function<void(Map*)> message)
     m_messageVector.push_back(message);
 }
 
+void Map::AddSpawnWork(MapSpawnWork const& work)
+{
+    std::lock_guard<std::mutex> guard(m_spawnWorkMutex);
+    m_spawnWork.push_back(work);
+    m_hasSpawnWork = true;
+}
+
+void Map::ProcessSpawnWork()
+{
+    uint32 budget = sWorld.getConfig(CONFIG_UINT32_GAME_EVENT_SPAWN_BUDGET);
+    uint32 startTime = WorldTimer::getMSTime();
+
+    // the work is queued from the world thread, the lock is not held while applying it
+    std::unique_lock<std::mutex> lock(m_spawnWorkMutex);
+    while (!m_spawnWork.empty())
+    {
+        MapSpawnWork work = m_spawnWork.front();
+        m_spawnWork.pop_front();
+        lock.unlock();
+
+        switch (work.type)
+        {
+            case SPAWN_WORK_SPAWN_CREATURE:
+                // the creature can be loaded with its grid since the work was queued, SpawnInMap skips it then
+                if (CreatureData const* data = sObjectMgr.GetCreatureData(work.dbGuid))
+                    Creature::SpawnInMap(this, work.dbGuid, data);
+                break;
+            case SPAWN_WORK_REMOVE_CREATURE:
+                if (CreatureData const* data = sObjectMgr.GetCreatureData(work.dbGuid))
+                    Creature::AddToRemoveListInMap(this, work.dbGuid, data);
+                break;
+            case SPAWN_WORK_SPAWN_GAMEOBJECT:
+                if (GameObjectData const* data = sObjectMgr.GetGOData(work.dbGuid))
+                    GameObject::SpawnInMap(this, work.dbGuid, data);
+                break;
+            case SPAWN_WORK_REMOVE_GAMEOBJECT:
+                if (GameObjectData const* data = sObjectMgr.GetGOData(work.dbGuid))
+                    GameObject::AddToRemoveListInMap(this, work.dbGuid, data);
+                break;
+            case SPAWN_WORK_APPLY_CREATURE_EVENT_DATA:
+            case SPAWN_WORK_RESTORE_CREATURE_EVENT_DATA:
+            {
+                CreatureData const* data = sObjectMgr.GetCreatureData(work.dbGuid);
+                if (!data)
+                    break;
+
+                if (Creature* creature = GetCreature(data->GetObjectGuid(work.dbGuid)))
+                {
+                    bool activate = work.type == SPAWN_WORK_APPLY_CREATURE_EVENT_DATA;
+                    creature->UpdateEntry(data->id, TEAM_NONE, data, activate ? work.eventData : nullptr);
+
+                    // spells not casted for event remove case (sent nullptr into update), do it
+                    if (!activate)
+                        creature->ApplyGameEventSpells(work.eventData, false);
+                }
+                break;
+            }
+            case SPAWN_WORK_SPAWN_POOL:
+                sPoolMgr.SpawnPool(*GetPersistentState(), work.dbGuid, work.param != 0);
+                break;
+            case SPAWN_WORK_DESPAWN_POOL:
+                sPoolMgr.DespawnPool(*GetPersistentState(), work.dbGuid);
+                break;
+            case SPAWN_WORK_UPDATE_CREATURE_POOL:
+                sPoolMgr.UpdatePool<Creature>(*GetPersistentState(), work.dbGuid, work.param);
+                break;
+            case SPAWN_WORK_UPDATE_GAMEOBJECT_POOL:
+                sPoolMgr.UpdatePool<GameObject>(*GetPersistentState(), work.dbGuid, work.param);
+                break;
+            case SPAWN_WORK_UPDATE_POOL_POOL:
+                sPoolMgr.UpdatePool<Pool>(*GetPersistentState(), work.dbGuid, work.param);
+                break;
+        }
+
+        if (budget && WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()) >= budget)
+            return;
+
+        lock.lock();
+    }
+
+    m_hasSpawnWork = false;
+}
+
 bool Map::IsMountAllowed() const
 {
     if (!IsDungeon())
@@ -25,6 +25,7 @@
 
 #include "Server/DBCStructure.h"
 #include "Maps/GridDefines.h"
+#include "Maps/CellPositionIndex.h"
 #include "Grids/Cell.h"
 #include "Entities/Object.h"
 #include "Globals/SharedDefines.h"
@@ -34,8 +35,11 @@
 #include "DBScripts/ScriptMgr.h"
 #include "Entities/CreatureLinkingMgr.h"
 #include "vmap/DynamicTree.h"
+#include "World/TickProfiler.h"
 
-#include <bitset>
+#include <atomic>
+#include <deque>
+#include <mutex>
 
 struct CreatureInfo;
 class Creature;
@@ -52,6 +56,7 @@ class BattleGround;
 class GridMap;
 class GameObjectModel;
 class WeatherSystem;
+struct GameEventCreatureData;
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -92,6 +97,33 @@ enum LevelRequirementVsMode
 
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
 
+// spawn changes of game events, queued to every loaded map of the event objects and applied by the map update
+enum MapSpawnWorkType
+{
+    SPAWN_WORK_SPAWN_CREATURE               = 0,
+    SPAWN_WORK_REMOVE_CREATURE              = 1,
+    SPAWN_WORK_SPAWN_GAMEOBJECT             = 2,
+    SPAWN_WORK_REMOVE_GAMEOBJECT            = 3,
+    SPAWN_WORK_APPLY_CREATURE_EVENT_DATA    = 4,            // change equipment or model of an event creature
+    SPAWN_WORK_RESTORE_CREATURE_EVENT_DATA  = 5,
+    SPAWN_WORK_SPAWN_POOL                   = 6,            // dbGuid is the pool id, param the instantly flag
+    SPAWN_WORK_DESPAWN_POOL                 = 7,
+    SPAWN_WORK_UPDATE_CREATURE_POOL         = 8,            // dbGuid is the pool id, param the changed creature guid or 0
+    SPAWN_WORK_UPDATE_GAMEOBJECT_POOL       = 9,
+    SPAWN_WORK_UPDATE_POOL_POOL             = 10,
+};
+
+struct MapSpawnWork
+{
+    MapSpawnWork(MapSpawnWorkType _type, uint32 _dbGuid, GameEventCreatureData const* _eventData = nullptr, uint32 _param = 0)
+        : type(_type), dbGuid(_dbGuid), eventData(_eventData), param(_param) {}
+
+    MapSpawnWorkType type;
+    uint32 dbGuid;
+    GameEventCreatureData const* eventData;                 // only for the creature event data work
+    uint32 param;                                           // only for the pool work
+};
+
 class Map : public GridRefManager<NGridType>
 {
         friend class MapReference;
@@ -124,6 +156,7 @@ class Map : public GridRefManager<NGridType>
 
         void MessageBroadcast(Player const*, WorldPacket const&, bool to_self);
         void MessageBroadcast(WorldObject const*, WorldPacket const&);
+        void MessageBroadcast(WorldObject const*, std::vector<WorldPacket> const&, Player const* skipped_receiver);
         void MessageDistBroadcast(Player const*, WorldPacket const&, float dist, bool to_self, bool own_team_only = false);
         void MessageDistBroadcast(WorldObject const*, WorldPacket const&, float dist);
         void MessageMapBroadcast(WorldObject const* obj, WorldPacket const& msg);
@@ -136,14 +169,26 @@ class Map : public GridRefManager<NGridType>
         void ExecuteMapWorkerArea(uint32 areaId, std::function<void(Player*)> const& worker);
 
         float GetVisibilityDistance() const { return m_VisibleDistance; }
+        // idle objects farther than this from all players and active objects are updated at reduced rate, 0 if disabled
+        float GetUpdateLodDistance() const { return m_updateLodDistance; }
         // function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
+        // recalculates the active cells after the visibility or update LOD distance changed
+        void RefreshActiveCells();
 
         void PlayerRelocation(Player*, float x, float y, float z, float angl);
         void CreatureRelocation(Creature* creature, float x, float y, float z, float orientation);
 
         template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor);
 
+        // packed unit positions of the cell, the grid must be created
+        CellPositionIndex& GetCellPositions(Cell const& cell)
+        {
+            return m_cellPositions[cell.GridX()][cell.GridY()][cell.CellX() * MAX_NUMBER_OF_CELLS + cell.CellY()];
+        }
+        // same as above, but returns nullptr (or loads the grid) in the same cases Visit() skips (or loads) the cell
+        CellPositionIndex const* GetVisitableCellPositions(Cell const& cell);
+
         bool IsRemovalGrid(float x, float y) const
         {
             GridPair p = MaNGOS::ComputeGridPair(x, y);
@@ -207,9 +252,9 @@ class Map : public GridRefManager<NGridType>
 
         void UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair);
 
-        void resetMarkedCells() { marked_cells.reset(); }
-        bool isCellMarked(uint32 pCellId) const { return marked_cells.test(pCellId); }
-        void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
+        // cells within visibility distance of players and active objects, these are updated every tick
+        void UpdateActiveCellSource(WorldObject const* obj);
+        void RemoveActiveCellSource(WorldObject const* obj);
 
         bool HavePlayers() const { return !m_mapRefManager.isEmpty(); }
         uint32 GetPlayersCountExceptGMs() const;
@@ -316,6 +361,18 @@ class Map : public GridRefManager<NGridType>
 
         void AddMessage(std::function<void(Map*)> message);
 
+        // game event spawn changes are applied in the following map updates, limited by the Event.SpawnBudget time
+        void AddSpawnWork(MapSpawnWork const& work);
+
+        // Chase/follow repath scheduler, error is how far (in yards) the current movement destination is off
+        void RequestRepath(Unit const* unit, float error);
+
+        // queues a periodic aura log entry, the entries of a tick are sent after the object updates
+        // with one SMSG_PERIODICAURALOG per target, caster and spell
+        void AddPeriodicAuraLog(Unit const* target, ObjectGuid casterGuid, uint32 spellId, ByteBuffer const& entry);
+        // sends the queued logs of the target right away, used before it dies so the killing tick is shown before the kill
+        void SendPeriodicAuraLogs(Unit* target);
+
         uint32 SpawnedCountForEntry(uint32 entry);
         void AddToSpawnCount(const ObjectGuid& guid);
         void RemoveFromSpawnCount(const ObjectGuid& guid);
@@ -323,6 +380,10 @@ class Map : public GridRefManager<NGridType>
         TimePoint GetCurrentClockTime();
         uint32 GetCurrentDiff();
 
+        // phase times of the last map updates, filled while the tick profiler is enabled
+        TickTimings& GetTickTimings() { return m_tickTimings; }
+        TickTimings const& GetTickTimings() const { return m_tickTimings; }
+
     private:
         void LoadMapAndVMap(int gx, int gy);
 
@@ -358,6 +419,39 @@ class Map : public GridRefManager<NGridType>
         void SendObjectUpdates();
         std::set<Object*> i_objectsToClientUpdate;
 
+        void ProcessRepathRequests();
+
+        struct RepathRequest
+        {
+            RepathRequest() : error(0.0f), waitTicks(0) {}
+            float error;
+            uint32 waitTicks;                               // map updates the request was already postponed
+        };
+        typedef std::unordered_map<ObjectGuid, RepathRequest> RepathRequestMap;
+        RepathRequestMap m_repathRequests;
+
+        void SendPeriodicAuraLogs();
+
+        struct PeriodicAuraLog
+        {
+            PeriodicAuraLog(ObjectGuid caster, uint32 spell) : casterGuid(caster), spellId(spell), count(0) {}
+            ObjectGuid casterGuid;
+            uint32 spellId;
+            uint32 count;
+            ByteBuffer entries;
+        };
+
+        void SendPeriodicAuraLogs(Unit* target, std::vector<PeriodicAuraLog> const& logs, std::vector<WorldPacket>& packets);
+        typedef std::unordered_map<ObjectGuid, std::vector<PeriodicAuraLog> > PeriodicAuraLogMap;
+        PeriodicAuraLogMap m_periodicAuraLogs;              // target -> logs of the running tick
+
+        TickTimings m_tickTimings;
+
+        void ProcessSpawnWork();
+        std::atomic<bool> m_hasSpawnWork;                   // lets the map update skip the phase without locking
+        std::deque<MapSpawnWork> m_spawnWork;
+        std::mutex m_spawnWorkMutex;
+
     protected:
         MapEntry const* i_mapEntry;
         uint8 i_spawnMode;
@@ -365,6 +459,7 @@ class Map : public GridRefManager<NGridType>
         uint32 i_InstanceId;
         uint32 m_unloadTimer;
         float m_VisibleDistance;
+        float m_updateLodDistance;
         MapPersistentState* m_persistentState;
 
         MapRefManager m_mapRefManager;
@@ -385,18 +480,55 @@ class Map : public GridRefManager<NGridType>
         time_t i_gridExpiry;
 
         NGridType* i_grids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        CellPositionIndex* m_cellPositions[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS]; // MAX_NUMBER_OF_CELLS^2 per created grid
 
         // Shared geodata object with map coord info...
         TerrainInfo* const m_TerrainData;
         bool m_bLoadedGrids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
-        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        struct ActiveCellSource
+        {
+            CellArea area;                                  // cells within visibility distance
+            CellArea nearArea;                              // cells within update LOD distance, updated at full rate
+        };
+
+        struct ActiveCellRefs
+        {
+            ActiveCellRefs() : sources(0), nearSources(0) {}
+
+            uint32 sources;                                 // number of sources having the cell in their area
+            uint32 nearSources;                             // same for near area
+        };
+
+        ActiveCellSource CalculateActiveCellSource(WorldObject const* obj) const;
+        void ChangeActiveCells(ActiveCellSource const& source, bool add);
+
+        typedef std::unordered_map<WorldObject const*, ActiveCellSource> ActiveCellSources;
+        ActiveCellSources m_activeCellSources;              // cell areas each player/active object keeps active
+        std::unordered_map<uint32, ActiveCellRefs> m_activeCells;
+        std::vector<std::pair<uint32, bool> > m_activeCellList; // sorted active cell ids and whether they are near a source, rebuilt at update if changed
+        bool m_activeCellsChanged;
 
         std::set<WorldObject*> i_objectsToRemove;
 
-        typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
+        // script steps ordered by execution time (steps due at the same time keep their scheduling order)
+        typedef std::multimap<TimePoint, ScriptAction> ScriptScheduleMap;
         ScriptScheduleMap m_scriptSchedule;
 
+        // scheduled steps by script table and id, lets script termination and unique starts skip unrelated scripts
+        typedef std::pair<char const*, uint32> ScriptKey;
+        struct ScriptKeyHash
+        {
+            size_t operator()(ScriptKey const& key) const { return std::hash<char const*>()(key.first) ^ (size_t(key.second) * 2654435761u); }
+        };
+        typedef std::unordered_map<ScriptKey, std::vector<ScriptScheduleMap::iterator>, ScriptKeyHash> ScriptScheduleIndex;
+        ScriptScheduleIndex m_scriptScheduleIndex;
+
+        void ScheduleScriptStep(uint32 delay, ScriptAction const& action);
+        void EraseScriptStep(ScriptScheduleMap::iterator step);
+        // removes all scheduled steps of the script, same matching rules as ScriptAction::IsSameScript
+        void TerminateScript(char const* table, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid);
+
         InstanceData* i_data;
         uint32 i_script_id;
 
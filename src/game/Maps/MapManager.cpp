@@ -83,7 +83,10 @@ void MapManager::UpdateGridState(grid_state_t state, Map& map, NGridType& ngrid,
 void MapManager::InitializeVisibilityDistanceInfo()
 {
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+    {
         (*iter).second->InitVisibilityDistance();
+        (*iter).second->RefreshActiveCells();
+    }
 }
 
 /// @param id - MapId of the to be created map. @param obj WorldObject for which the map is to be created. Must be player for Instancable maps.
@@ -173,7 +176,12 @@ void MapManager::Update(uint32 diff)
         return;
 
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+    {
+        TickTimings& timings = iter->second->GetTickTimings();
+        timings.StartTick();
         iter->second->Update((uint32)i_timer.GetCurrent());
+        timings.FinishTick(sTickProfiler.GetMapBudget());
+    }
 
     for (TransportSet::iterator iter = m_Transports.begin(); iter != m_Transports.end(); ++iter)
     {
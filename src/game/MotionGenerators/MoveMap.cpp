@@ -352,16 +352,20 @@ namespace MMAP
         }
 
         MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+
+        std::lock_guard<std::mutex> guard(mmap->navMeshQueriesLock);
+        NavMeshQuerySet::iterator itr = mmap->navMeshQueries.find(instanceId);
+        if (itr == mmap->navMeshQueries.end())
         {
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %03u instanceId %u", mapId, instanceId);
             return false;
         }
 
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
+        // free the queries of all threads that worked on this instance
+        for (ThreadNavMeshQuerySet::iterator i = itr->second.begin(); i != itr->second.end(); ++i)
+            delete i->second;
 
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
+        mmap->navMeshQueries.erase(itr);
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
 
         return true;
@@ -375,29 +379,119 @@ namespace MMAP
         return loadedMMaps[mapId]->navMesh;
     }
 
-    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
+    NavMeshQueryData* MMapManager::GetNavMeshQueryData(uint32 mapId, uint32 instanceId)
     {
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+        MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
             return nullptr;
 
-        MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        MMapData* mmap = itr->second;
+        std::thread::id threadId = std::this_thread::get_id();
+
+        std::lock_guard<std::mutex> guard(mmap->navMeshQueriesLock);
+        ThreadNavMeshQuerySet& threadQueries = mmap->navMeshQueries[instanceId];
+        ThreadNavMeshQuerySet::const_iterator queryItr = threadQueries.find(threadId);
+        if (queryItr != threadQueries.end())
+            return queryItr->second;
+
+        // allocate mesh query
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        MANGOS_ASSERT(query);
+        dtStatus dtResult = query->init(mmap->navMesh, 1024);
+        if (dtStatusFailed(dtResult))
         {
-            // allocate mesh query
-            dtNavMeshQuery* query = dtAllocNavMeshQuery();
-            MANGOS_ASSERT(query);
-            dtStatus dtResult = query->init(mmap->navMesh, 1024);
-            if (dtStatusFailed(dtResult))
+            dtFreeNavMeshQuery(query);
+            sLog.outError("MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
+            return nullptr;
+        }
+
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
+        NavMeshQueryData* queryData = new NavMeshQueryData(query);
+        threadQueries.insert(ThreadNavMeshQuerySet::value_type(threadId, queryData));
+        return queryData;
+    }
+
+    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
+    {
+        NavMeshQueryData* queryData = GetNavMeshQueryData(mapId, instanceId);
+        return queryData ? queryData->query : nullptr;
+    }
+
+    // ######################## PolyPathCache ########################
+    uint32 PolyPathCache::find(dtNavMesh const* navMesh, dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef* path, uint32 maxPathSize)
+    {
+        for (std::list<Entry>::iterator itr = m_entries.begin(); itr != m_entries.end();)
+        {
+            Entry& entry = *itr;
+            if (entry.corridor.back() != endPoly || entry.includeFlags != filter.getIncludeFlags() || entry.excludeFlags != filter.getExcludeFlags())
+            {
+                ++itr;
+                continue;
+            }
+
+            // sub-path of optimal path is optimal, cut the corridor at our start poly
+            std::vector<dtPolyRef>::iterator startItr = std::find(entry.corridor.begin(), entry.corridor.end(), startPoly);
+            if (startItr == entry.corridor.end())
+            {
+                ++itr;
+                continue;
+            }
+
+            uint32 pathSize = uint32(entry.corridor.end() - startItr);
+            if (pathSize > maxPathSize)
+            {
+                ++itr;
+                continue;
+            }
+
+            // tiles may have been reloaded since the corridor was stored
+            bool valid = true;
+            for (std::vector<dtPolyRef>::const_iterator polyItr = startItr; polyItr != entry.corridor.end(); ++polyItr)
+            {
+                if (!navMesh->isValidPolyRef(*polyItr))
+                {
+                    valid = false;
+                    break;
+                }
+            }
+
+            if (!valid)
             {
-                dtFreeNavMeshQuery(query);
-                sLog.outError("MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-                return nullptr;
+                itr = m_entries.erase(itr);
+                continue;
             }
 
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-            mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
+            std::copy(startItr, entry.corridor.end(), path);
+            m_entries.splice(m_entries.begin(), m_entries, itr);
+            return pathSize;
         }
 
-        return mmap->navMeshQueries[instanceId];
+        return 0;
+    }
+
+    void PolyPathCache::store(dtPolyRef const* path, uint32 pathSize, dtQueryFilter const& filter)
+    {
+        if (!pathSize)
+            return;
+
+        // replace the corridor between the same polys, if any
+        for (std::list<Entry>::iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+        {
+            if (itr->corridor.front() == path[0] && itr->corridor.back() == path[pathSize - 1] &&
+                    itr->includeFlags == filter.getIncludeFlags() && itr->excludeFlags == filter.getExcludeFlags())
+            {
+                m_entries.erase(itr);
+                break;
+            }
+        }
+
+        if (m_entries.size() >= MAX_ENTRIES)
+            m_entries.pop_back();
+
+        m_entries.push_front(Entry());
+        Entry& entry = m_entries.front();
+        entry.includeFlags = filter.getIncludeFlags();
+        entry.excludeFlags = filter.getExcludeFlags();
+        entry.corridor.assign(path, path + pathSize);
     }
 }
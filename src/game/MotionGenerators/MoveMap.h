@@ -20,6 +20,8 @@
 #define _MOVE_MAP_H
 
 #include "Common.h"
+#include <mutex>
+#include <thread>
 #include <Detour/Include/DetourAlloc.h>
 #include <Detour/Include/DetourNavMesh.h>
 #include <Detour/Include/DetourNavMeshQuery.h>
@@ -41,7 +43,47 @@ inline void dtCustomFree(void* ptr)
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+
+    // small LRU cache of poly corridors found by path finding on one map instance
+    // units heading for the same end polygon (chasing the same target) reuse the
+    // part of a cached corridor that starts at their own polygon
+    class PolyPathCache
+    {
+        public:
+            static uint32 const MAX_ENTRIES = 64;
+
+            // copies the cached corridor from startPoly to endPoly into path
+            // returns the corridor length, 0 if nothing usable is cached
+            uint32 find(dtNavMesh const* navMesh, dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef* path, uint32 maxPathSize);
+
+            // only complete corridors should be stored, the last poly is used as key
+            void store(dtPolyRef const* path, uint32 pathSize, dtQueryFilter const& filter);
+
+            void clear() { m_entries.clear(); }
+
+        private:
+            struct Entry
+            {
+                uint16 includeFlags;
+                uint16 excludeFlags;
+                std::vector<dtPolyRef> corridor;
+            };
+
+            std::list<Entry> m_entries;         // most recently used first
+    };
+
+    // path finding data of one map instance, owned by a single thread
+    struct NavMeshQueryData
+    {
+        NavMeshQueryData(dtNavMeshQuery* _query) : query(_query) {}
+        ~NavMeshQueryData() { dtFreeNavMeshQuery(query); }
+
+        dtNavMeshQuery* query;
+        PolyPathCache pathCache;
+    };
+
+    typedef std::unordered_map<std::thread::id, NavMeshQueryData*> ThreadNavMeshQuerySet;
+    typedef std::unordered_map<uint32, ThreadNavMeshQuerySet> NavMeshQuerySet;
 
     // dummy struct to hold map's mmap data
     struct MMapData
@@ -50,7 +92,8 @@ namespace MMAP
         ~MMapData()
         {
             for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
-                dtFreeNavMeshQuery(i->second);
+                for (ThreadNavMeshQuerySet::iterator j = i->second.begin(); j != i->second.end(); ++j)
+                    delete j->second;
 
             if (navMesh)
                 dtFreeNavMesh(navMesh);
@@ -58,8 +101,9 @@ namespace MMAP
 
         dtNavMesh* navMesh;
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries;     // instanceId to query
+        // dtNavMeshQuery is not thread safe, so every thread gets its own one per instance
+        NavMeshQuerySet navMeshQueries;     // instanceId to thread to query
+        std::mutex navMeshQueriesLock;
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
     };
 
@@ -79,7 +123,8 @@ namespace MMAP
             bool unloadMap(uint32 mapId);
             bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
-            // the returned [dtNavMeshQuery const*] is NOT threadsafe
+            // the returned data belongs to the calling thread and must not be shared with others
+            NavMeshQueryData* GetNavMeshQueryData(uint32 mapId, uint32 instanceId);
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
@@ -50,6 +50,9 @@ class MovementGenerator
 
         virtual void unitSpeedChanged() { }
 
+        // called by the map repath scheduler for requests made with Map::RequestRepath
+        virtual void ProcessScheduledRepath(Unit&) { }
+
         // used by Evade code for select point to evade with expected restart default movement
         virtual bool GetResetPosition(Unit&, float& /*x*/, float& /*y*/, float& /*z*/, float& o) const { return false; }
 
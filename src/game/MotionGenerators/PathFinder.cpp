@@ -30,7 +30,7 @@
 PathFinder::PathFinder(const Unit* owner) :
     m_polyLength(0), m_type(PATHFIND_BLANK),
     m_useStraightPath(false), m_forceDestination(false), m_pointPathLimit(MAX_POINT_PATH_LENGTH),
-    m_sourceUnit(owner), m_navMesh(nullptr), m_navMeshQuery(nullptr)
+    m_sourceUnit(owner), m_navMesh(nullptr), m_navMeshQuery(nullptr), m_pathCache(nullptr)
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::PathInfo for %u \n", m_sourceUnit->GetGUIDLow());
 
@@ -39,7 +39,7 @@ PathFinder::PathFinder(const Unit* owner) :
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         m_navMesh = mmap->GetNavMesh(mapId);
-        m_navMeshQuery = mmap->GetNavMeshQuery(mapId, m_sourceUnit->GetInstanceId());
+        updateNavMeshQuery();
     }
 
     createFilter();
@@ -70,6 +70,10 @@ bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest
 
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::calculate() for %u \n", m_sourceUnit->GetGUIDLow());
 
+    // queries are per thread, fetch the one of the thread we are running in now
+    if (m_navMesh && m_queryThreadId != std::this_thread::get_id())
+        updateNavMeshQuery();
+
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     if (!m_navMesh || !m_navMeshQuery || m_sourceUnit->hasUnitState(UNIT_STAT_IGNORE_PATHFINDING) ||
@@ -86,6 +90,15 @@ bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest
     return true;
 }
 
+void PathFinder::updateNavMeshQuery()
+{
+    m_queryThreadId = std::this_thread::get_id();
+
+    MMAP::NavMeshQueryData* queryData = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshQueryData(m_sourceUnit->GetMapId(), m_sourceUnit->GetInstanceId());
+    m_navMeshQuery = queryData ? queryData->query : nullptr;
+    m_pathCache = queryData ? &queryData->pathCache : nullptr;
+}
+
 dtPolyRef PathFinder::getPathPolyByPosition(const dtPolyRef* polyPath, uint32 polyPathSize, const float* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -375,23 +388,34 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         // free and invalidate old path data
         clear();
 
-        dtResult = m_navMeshQuery->findPath(
-                       startPoly,          // start polygon
-                       endPoly,            // end polygon
-                       startPoint,         // start position
-                       endPoint,           // end position
-                       &m_filter,           // polygon search filter
-                       m_pathPolyRefs,     // [out] path
-                       (int*)&m_polyLength,
-                       MAX_PATH_LENGTH);   // max number of polygons in output path
-
-        if (!m_polyLength || dtStatusFailed(dtResult))
+        // other units may already have found a way from here to the same end poly (chasing the same target)
+        m_polyLength = m_pathCache->find(m_navMesh, startPoly, endPoly, m_filter, m_pathPolyRefs, MAX_PATH_LENGTH);
+        if (m_polyLength)
+            DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: reused cached corridor, m_polyLength=%u\n", m_polyLength);
+        else
         {
-            // only happens if we passed bad data to findPath(), or navmesh is messed up
-            sLog.outError("%u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
-            BuildShortcut();
-            m_type = PATHFIND_NOPATH;
-            return;
+            dtResult = m_navMeshQuery->findPath(
+                           startPoly,          // start polygon
+                           endPoly,            // end polygon
+                           startPoint,         // start position
+                           endPoint,           // end position
+                           &m_filter,           // polygon search filter
+                           m_pathPolyRefs,     // [out] path
+                           (int*)&m_polyLength,
+                           MAX_PATH_LENGTH);   // max number of polygons in output path
+
+            if (!m_polyLength || dtStatusFailed(dtResult))
+            {
+                // only happens if we passed bad data to findPath(), or navmesh is messed up
+                sLog.outError("%u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
+                BuildShortcut();
+                m_type = PATHFIND_NOPATH;
+                return;
+            }
+
+            // partial paths are not worth sharing
+            if (m_pathPolyRefs[m_polyLength - 1] == endPoly)
+                m_pathCache->store(m_pathPolyRefs, m_polyLength, m_filter);
         }
     }
 
@@ -26,11 +26,18 @@
 
 #include "Movement/MoveSplineInitArgs.h"
 
+#include <thread>
+
 using Movement::Vector3;
 using Movement::PointsArray;
 
 class Unit;
 
+namespace MMAP
+{
+    class PolyPathCache;
+}
+
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
 // I think we can safely cut those down even more
@@ -100,6 +107,8 @@ class PathFinder
         const Unit* const       m_sourceUnit;       // the unit that is moving
         const dtNavMesh*        m_navMesh;          // the nav mesh
         const dtNavMeshQuery*   m_navMeshQuery;     // the nav mesh query used to find the path
+        MMAP::PolyPathCache*    m_pathCache;        // corridors recently found by units of the same thread
+        std::thread::id         m_queryThreadId;    // thread owning m_navMeshQuery and m_pathCache
 
         dtQueryFilter m_filter;                     // use single filter for all movements, update it when needed
 
@@ -114,6 +123,8 @@ class PathFinder
             m_pathPoints.clear();
         }
 
+        void updateNavMeshQuery();
+
         bool inRange(const Vector3& p1, const Vector3& p2, float r, float h) const;
         float dist3DSqr(const Vector3& p1, const Vector3& p2) const;
         bool inRangeYZX(const float* v1, const float* v2, float r, float h) const;
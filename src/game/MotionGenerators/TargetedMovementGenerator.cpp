@@ -22,9 +22,13 @@
 #include "Entities/Creature.h"
 #include "Entities/Player.h"
 #include "World/World.h"
+#include "Maps/Map.h"
 #include "Movement/MoveSplineInit.h"
 #include "Movement/MoveSpline.h"
 
+// Max distance between new and running spline destination for which the running spline is kept
+#define REPATH_SAME_DESTINATION_DIST                      0.5f
+
 //-----------------------------------------------//
 template<class T, typename D>
 void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T& owner, bool updateDestination)
@@ -79,6 +83,16 @@ void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T& owner, bool up
     if (i_path->getPathType() & PATHFIND_NOPATH)
         return;
 
+    // the running spline already ends where the new path ends, only its tail was recalculated
+    // no need to relaunch it and send a new movement packet
+    if (updateDestination && !m_speedChanged && !owner.movespline->Finalized())
+    {
+        G3D::Vector3 end = i_path->getEndPosition();
+        G3D::Vector3 dest = owner.movespline->FinalDestination();
+        if ((end - dest).squaredLength() < REPATH_SAME_DESTINATION_DIST * REPATH_SAME_DESTINATION_DIST)
+            return;
+    }
+
     D::_addUnitStateMove(owner);
     i_targetReached = false;
     m_speedChanged = false;
@@ -132,6 +146,22 @@ bool TargetedMovementGeneratorMedium<T, D>::Update(T& owner, const uint32& time_
         i_recheckDistance.Reset(this->GetMovementGeneratorType() == FOLLOW_MOTION_TYPE ? 50 : 100);
         G3D::Vector3 dest = owner.movespline->FinalDestination();
         targetMoved = RequiresNewPosition(owner, dest.x, dest.y, dest.z);
+
+        // let the map spread repaths over several updates, the units furthest off their target first
+        if (targetMoved && sWorld.getConfig(CONFIG_UINT32_PATH_FIND_REPATH_BUDGET))
+        {
+            float error = i_target->GetDistance(dest.x, dest.y, dest.z) - this->GetDynamicTargetDistance(owner, true);
+            owner.GetMap()->RequestRepath(&owner, error);
+            i_repathPending = true;
+            targetMoved = false;
+        }
+    }
+
+    if (m_speedChanged)
+    {
+        // speed changes can't wait, pick up a pending repath at the same time
+        targetMoved = targetMoved || i_repathPending;
+        i_repathPending = false;
     }
 
     if (m_speedChanged || targetMoved)
@@ -151,6 +181,31 @@ bool TargetedMovementGeneratorMedium<T, D>::Update(T& owner, const uint32& time_
     return true;
 }
 
+template<class T, typename D>
+void TargetedMovementGeneratorMedium<T, D>::ProcessScheduledRepath(Unit& u)
+{
+    if (!i_repathPending)
+        return;
+
+    i_repathPending = false;
+
+    T& owner = static_cast<T&>(u);
+    if (!i_target.isValid() || !i_target->IsInWorld() || !owner.isAlive())
+        return;
+
+    // same conditions under which Update doesn't move the owner
+    if (owner.hasUnitState(UNIT_STAT_NOT_MOVE) || owner.IsNonMeleeSpellCasted(false, false, true))
+        return;
+
+    if (this->GetMovementGeneratorType() == CHASE_MOTION_TYPE && owner.hasUnitState(UNIT_STAT_NO_COMBAT_MOVEMENT))
+        return;
+
+    if (static_cast<D*>(this)->_lostTarget(owner))
+        return;
+
+    _setTargetLocation(owner, true);
+}
+
 template<class T, typename D>
 bool TargetedMovementGeneratorMedium<T, D>::IsReachable() const
 {
@@ -367,6 +422,10 @@ template bool TargetedMovementGeneratorMedium<Player, ChaseMovementGenerator<Pla
 template bool TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::IsReachable() const;
 template bool TargetedMovementGeneratorMedium<Creature, ChaseMovementGenerator<Creature> >::IsReachable() const;
 template bool TargetedMovementGeneratorMedium<Creature, FollowMovementGenerator<Creature> >::IsReachable() const;
+template void TargetedMovementGeneratorMedium<Player, ChaseMovementGenerator<Player> >::ProcessScheduledRepath(Unit&);
+template void TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::ProcessScheduledRepath(Unit&);
+template void TargetedMovementGeneratorMedium<Creature, ChaseMovementGenerator<Creature> >::ProcessScheduledRepath(Unit&);
+template void TargetedMovementGeneratorMedium<Creature, FollowMovementGenerator<Creature> >::ProcessScheduledRepath(Unit&);
 
 template void ChaseMovementGenerator<Player>::_clearUnitStateMove(Player& u);
 template void ChaseMovementGenerator<Creature>::_addUnitStateMove(Creature& u);
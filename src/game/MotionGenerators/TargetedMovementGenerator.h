@@ -43,7 +43,7 @@ class TargetedMovementGeneratorMedium
             TargetedMovementGeneratorBase(target),
             i_recheckDistance(0),
             i_offset(offset), i_angle(angle),
-            m_speedChanged(false), i_targetReached(false),
+            m_speedChanged(false), i_targetReached(false), i_repathPending(false),
             i_path(nullptr)
         {
         }
@@ -58,6 +58,8 @@ class TargetedMovementGeneratorMedium
 
         void unitSpeedChanged() { m_speedChanged = true; }
 
+        void ProcessScheduledRepath(Unit& u) override;
+
         void SetOffsetAndAngle(float offset, float angle);
 
     protected:
@@ -70,6 +72,7 @@ class TargetedMovementGeneratorMedium
         float i_angle;
         bool m_speedChanged : 1;
         bool i_targetReached : 1;
+        bool i_repathPending : 1;                           // waiting for the map repath scheduler
 
         PathFinder* i_path;
 };
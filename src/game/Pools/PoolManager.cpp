@@ -22,6 +22,7 @@
 #include "ProgressBar.h"
 #include "Log.h"
 #include "Maps/MapPersistentStateMgr.h"
+#include "Maps/Map.h"
 #include "World/World.h"
 #include "Policies/Singleton.h"
 
@@ -138,7 +139,10 @@ template <class T>
 void PoolGroup<T>::AddEntry(PoolObject& poolitem, uint32 maxentries)
 {
     if (poolitem.chance != 0 && maxentries == 1)
+    {
         ExplicitlyChanced.push_back(poolitem);
+        ExplicitlyChancedSums.push_back((ExplicitlyChancedSums.empty() ? 0.0f : ExplicitlyChancedSums.back()) + poolitem.chance);
+    }
     else
         EqualChanced.push_back(poolitem);
 }
@@ -169,6 +173,19 @@ void PoolGroup<T>::CheckEventLinkAndReport(int16 event_id, std::map<uint32, int1
         ExplicitlyChanced[i].template CheckEventLinkAndReport<T>(poolId, event_id, creature2event, go2event);
 }
 
+template <class T>
+void PoolGroup<T>::RebuildChanceSums()
+{
+    ExplicitlyChancedSums.resize(ExplicitlyChanced.size());
+
+    float sum = 0.0f;
+    for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i)
+    {
+        sum += ExplicitlyChanced[i].chance;
+        ExplicitlyChancedSums[i] = sum;
+    }
+}
+
 template <class T>
 void PoolGroup<T>::SetExcludeObject(uint32 guid, bool state)
 {
@@ -199,12 +216,13 @@ PoolObject* PoolGroup<T>::RollOne(SpawnedPoolData& spawns, uint32 triggerFrom)
     {
         float roll = (float)rand_chance();
 
-        for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i)
+        // rolled entry is the first one whose running chance sum exceeds the roll, if it can't be spawned the next ones are tried
+        size_t first = std::upper_bound(ExplicitlyChancedSums.begin(), ExplicitlyChancedSums.end(), roll) - ExplicitlyChancedSums.begin();
+        for (size_t i = first; i < ExplicitlyChanced.size(); ++i)
         {
-            roll -= ExplicitlyChanced[i].chance;
             // Triggering object is marked as spawned at this time and can be also rolled (respawn case)
             // so this need explicit check for this case
-            if (roll < 0 && !ExplicitlyChanced[i].exclude && (ExplicitlyChanced[i].guid == triggerFrom || !spawns.IsSpawnedObject<T>(ExplicitlyChanced[i].guid)))
+            if (!ExplicitlyChanced[i].exclude && (ExplicitlyChanced[i].guid == triggerFrom || !spawns.IsSpawnedObject<T>(ExplicitlyChanced[i].guid)))
                 return &ExplicitlyChanced[i];
         }
     }
@@ -227,31 +245,33 @@ PoolObject* PoolGroup<T>::RollOne(SpawnedPoolData& spawns, uint32 triggerFrom)
 template<class T>
 void PoolGroup<T>::DespawnObject(MapPersistentState& mapState, uint32 guid)
 {
+    // requested object is always a member of this pool, no need to search it in the lists
+    if (guid)
+    {
+        if (mapState.GetSpawnedPoolData().IsSpawnedObject<T>(guid))
+        {
+            Despawn1Object(mapState, guid);
+            mapState.GetSpawnedPoolData().RemoveSpawn<T>(guid, poolId);
+        }
+        return;
+    }
+
+    // despawn all spawned members
     for (size_t i = 0; i < EqualChanced.size(); ++i)
     {
-        // if spawned
         if (mapState.GetSpawnedPoolData().IsSpawnedObject<T>(EqualChanced[i].guid))
         {
-            // any or specially requested
-            if (!guid || EqualChanced[i].guid == guid)
-            {
-                Despawn1Object(mapState, EqualChanced[i].guid);
-                mapState.GetSpawnedPoolData().RemoveSpawn<T>(EqualChanced[i].guid, poolId);
-            }
+            Despawn1Object(mapState, EqualChanced[i].guid);
+            mapState.GetSpawnedPoolData().RemoveSpawn<T>(EqualChanced[i].guid, poolId);
         }
     }
 
     for (size_t i = 0; i < ExplicitlyChanced.size(); ++i)
     {
-        // spawned
         if (mapState.GetSpawnedPoolData().IsSpawnedObject<T>(ExplicitlyChanced[i].guid))
         {
-            // any or specially requested
-            if (!guid || ExplicitlyChanced[i].guid == guid)
-            {
-                Despawn1Object(mapState, ExplicitlyChanced[i].guid);
-                mapState.GetSpawnedPoolData().RemoveSpawn<T>(ExplicitlyChanced[i].guid, poolId);
-            }
+            Despawn1Object(mapState, ExplicitlyChanced[i].guid);
+            mapState.GetSpawnedPoolData().RemoveSpawn<T>(ExplicitlyChanced[i].guid, poolId);
         }
     }
 }
@@ -308,6 +328,7 @@ void PoolGroup<Pool>::RemoveOneRelation(uint16 child_pool_id)
         if (itr->guid == child_pool_id)
         {
             ExplicitlyChanced.erase(itr);
+            RebuildChanceSums();
             break;
         }
     }
@@ -1119,7 +1140,11 @@ struct SpawnPoolInMapsWorker
 
     void operator()(MapPersistentState* state)
     {
-        i_mgr.SpawnPool(*state, i_pool_id, i_instantly);
+        // loaded maps apply it in their update together with the other game event spawn changes
+        if (Map* map = state->GetMap())
+            map->AddSpawnWork(MapSpawnWork(SPAWN_WORK_SPAWN_POOL, i_pool_id, nullptr, i_instantly));
+        else
+            i_mgr.SpawnPool(*state, i_pool_id, i_instantly);
     }
 
     PoolManager& i_mgr;
@@ -1147,7 +1172,10 @@ struct DespawnPoolInMapsWorker
 
     void operator()(MapPersistentState* state)
     {
-        i_mgr.DespawnPool(*state, i_pool_id);
+        if (Map* map = state->GetMap())
+            map->AddSpawnWork(MapSpawnWork(SPAWN_WORK_DESPAWN_POOL, i_pool_id));
+        else
+            i_mgr.DespawnPool(*state, i_pool_id);
     }
 
     PoolManager& i_mgr;
@@ -1174,6 +1202,11 @@ void PoolManager::InitSpawnPool(MapPersistentState& mapState, uint16 pool_id)
         SpawnPool(mapState, pool_id, true);
 }
 
+template<typename T> MapSpawnWorkType GetUpdatePoolWorkType();
+template<> MapSpawnWorkType GetUpdatePoolWorkType<Creature>() { return SPAWN_WORK_UPDATE_CREATURE_POOL; }
+template<> MapSpawnWorkType GetUpdatePoolWorkType<GameObject>() { return SPAWN_WORK_UPDATE_GAMEOBJECT_POOL; }
+template<> MapSpawnWorkType GetUpdatePoolWorkType<Pool>() { return SPAWN_WORK_UPDATE_POOL_POOL; }
+
 template<typename T>
 struct UpdatePoolInMapsWorker
 {
@@ -1182,7 +1215,10 @@ struct UpdatePoolInMapsWorker
 
     void operator()(MapPersistentState* state)
     {
-        i_mgr.UpdatePool<T>(*state, i_pool_id, i_db_guid_or_pool_id);
+        if (Map* map = state->GetMap())
+            map->AddSpawnWork(MapSpawnWork(GetUpdatePoolWorkType<T>(), i_pool_id, nullptr, i_db_guid_or_pool_id));
+        else
+            i_mgr.UpdatePool<T>(*state, i_pool_id, i_db_guid_or_pool_id);
     }
 
     PoolManager& i_mgr;
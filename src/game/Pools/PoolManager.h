@@ -61,8 +61,9 @@ class Pool                                                  // for Pool of Pool
 {
 };
 
-typedef std::set<uint32> SpawnedPoolObjects;
-typedef std::map<uint32, uint32> SpawnedPoolPools;
+// looked up for every roll of a pool member, so hashed instead of ordered
+typedef std::unordered_set<uint32> SpawnedPoolObjects;
+typedef std::unordered_map<uint32, uint32> SpawnedPoolPools;
 
 class SpawnedPoolData
 {
@@ -121,9 +122,12 @@ class PoolGroup
 
         size_t size() const { return ExplicitlyChanced.size() + EqualChanced.size(); }
     private:
+        void RebuildChanceSums();
+
         uint32 poolId;
         PoolObjectList ExplicitlyChanced;
         PoolObjectList EqualChanced;
+        std::vector<float> ExplicitlyChancedSums;           // running sum of ExplicitlyChanced chances, used to find the rolled entry by binary search
 };
 
 class PoolManager
@@ -168,6 +172,7 @@ class PoolManager
         void UpdatePool(MapPersistentState& mapState, uint16 pool_id, uint32 db_guid_or_pool_id = 0);
 
         // used for calling from global systems when need spawn pool in all appropriate map instances
+        // loaded maps get the change queued as spawn work and apply it in their updates
         void SpawnPoolInMaps(uint16 pool_id, bool instantly);
         void DespawnPoolInMaps(uint16 pool_id);
 
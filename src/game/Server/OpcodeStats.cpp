@@ -0,0 +1,173 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Server/OpcodeStats.h"
+#include "Server/Opcodes.h"
+#include "Config/Config.h"
+#include "Log.h"
+
+#include <algorithm>
+
+INSTANTIATE_SINGLETON_1(OpcodeStatsMgr);
+
+OpcodeStatsMgr::OpcodeStatsMgr() : m_stats(NUM_MSG_TYPES), m_startTime(Clock::now()), m_enabled(false)
+{
+}
+
+void OpcodeStatsMgr::SetDumpFile(std::string const& fileName)
+{
+    m_dumpFile.clear();
+    if (fileName.empty())
+        return;
+
+    m_dumpFile = sConfig.GetStringDefault("LogsDir");
+    if (!m_dumpFile.empty() && m_dumpFile.back() != '/' && m_dumpFile.back() != '\\')
+        m_dumpFile.append("/");
+
+    m_dumpFile.append(fileName);
+}
+
+void OpcodeStatsMgr::AddSample(uint16 opcode, Clock::duration elapsed)
+{
+    if (opcode >= NUM_MSG_TYPES)
+        return;
+
+    uint64 time = uint64(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+
+    OpcodeStat& stat = m_stats[opcode];
+    ++stat.count;
+    stat.totalTime += time;
+    if (time > stat.maxTime)
+        stat.maxTime = time;
+
+    uint32 bucket = 0;
+    while (time && bucket < OPCODE_STATS_BUCKETS - 1)
+    {
+        time >>= 1;
+        ++bucket;
+    }
+    ++stat.buckets[bucket];
+}
+
+void OpcodeStatsMgr::Reset()
+{
+    std::fill(m_stats.begin(), m_stats.end(), OpcodeStat());
+    m_startTime = Clock::now();
+}
+
+void OpcodeStatsMgr::GetTopOpcodes(std::vector<uint16>& opcodes, uint32 limit) const
+{
+    opcodes.clear();
+    for (uint16 i = 0; i < NUM_MSG_TYPES; ++i)
+        if (m_stats[i].count)
+            opcodes.push_back(i);
+
+    auto byTotalTime = [this](uint16 a, uint16 b) { return m_stats[a].totalTime > m_stats[b].totalTime; };
+    if (limit && opcodes.size() > limit)
+    {
+        std::partial_sort(opcodes.begin(), opcodes.begin() + limit, opcodes.end(), byTotalTime);
+        opcodes.resize(limit);
+    }
+    else
+        std::sort(opcodes.begin(), opcodes.end(), byTotalTime);
+}
+
+uint64 OpcodeStatsMgr::GetPercentile(OpcodeStat const& stat, float percentile)
+{
+    if (!stat.count)
+        return 0;
+
+    uint64 rank = uint64(stat.count * percentile / 100.0f);
+    if (rank >= stat.count)
+        rank = stat.count - 1;
+
+    uint64 seen = 0;
+    for (uint32 i = 0; i < OPCODE_STATS_BUCKETS; ++i)
+    {
+        seen += stat.buckets[i];
+        if (seen > rank)
+            return uint64(1) << i;
+    }
+
+    return stat.maxTime;
+}
+
+bool OpcodeStatsMgr::Dump() const
+{
+    if (m_dumpFile.empty())
+        return false;
+
+    FILE* file = fopen(m_dumpFile.c_str(), "w");
+    if (!file)
+    {
+        sLog.outError("OpcodeStats: can't open dump file %s", m_dumpFile.c_str());
+        return false;
+    }
+
+    std::string::size_type dotPos = m_dumpFile.find_last_of('.');
+    if (dotPos != std::string::npos && m_dumpFile.compare(dotPos, std::string::npos, ".json") == 0)
+        DumpJson(file);
+    else
+        DumpCsv(file);
+
+    fclose(file);
+    return true;
+}
+
+void OpcodeStatsMgr::DumpCsv(FILE* file) const
+{
+    fprintf(file, "opcode,name,count,total_us,avg_us,max_us,p50_us,p99_us");
+    for (uint32 i = 0; i < OPCODE_STATS_BUCKETS; ++i)
+        fprintf(file, ",bucket_%u", i);
+    fprintf(file, "\n");
+
+    std::vector<uint16> opcodes;
+    GetTopOpcodes(opcodes, 0);
+    for (uint16 opcode : opcodes)
+    {
+        OpcodeStat const& stat = m_stats[opcode];
+        fprintf(file, "%u,%s," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD,
+                uint32(opcode), LookupOpcodeName(opcode), stat.count, stat.totalTime, stat.totalTime / stat.count,
+                stat.maxTime, GetPercentile(stat, 50.0f), GetPercentile(stat, 99.0f));
+        for (uint32 i = 0; i < OPCODE_STATS_BUCKETS; ++i)
+            fprintf(file, "," UI64FMTD, stat.buckets[i]);
+        fprintf(file, "\n");
+    }
+}
+
+void OpcodeStatsMgr::DumpJson(FILE* file) const
+{
+    uint64 uptime = uint64(std::chrono::duration_cast<std::chrono::seconds>(Clock::now() - m_startTime).count());
+    fprintf(file, "{\n  \"collected_seconds\": " UI64FMTD ",\n  \"opcodes\": [", uptime);
+
+    std::vector<uint16> opcodes;
+    GetTopOpcodes(opcodes, 0);
+    for (std::size_t i = 0; i < opcodes.size(); ++i)
+    {
+        OpcodeStat const& stat = m_stats[opcodes[i]];
+        fprintf(file, "%s\n    { \"opcode\": %u, \"name\": \"%s\", \"count\": " UI64FMTD ", \"total_us\": " UI64FMTD
+                ", \"max_us\": " UI64FMTD ", \"p50_us\": " UI64FMTD ", \"p99_us\": " UI64FMTD ", \"buckets\": [",
+                i ? "," : "", uint32(opcodes[i]), LookupOpcodeName(opcodes[i]), stat.count, stat.totalTime,
+                stat.maxTime, GetPercentile(stat, 50.0f), GetPercentile(stat, 99.0f));
+        for (uint32 j = 0; j < OPCODE_STATS_BUCKETS; ++j)
+            fprintf(file, j ? ", " UI64FMTD : UI64FMTD, stat.buckets[j]);
+        fprintf(file, "] }");
+    }
+
+    fprintf(file, "\n  ]\n}\n");
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup u2w
+/// @{
+/// \file
+
+#ifndef MANGOS_OPCODE_STATS_H
+#define MANGOS_OPCODE_STATS_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <chrono>
+
+/// Number of latency buckets, bucket 0 holds handlers faster than 1us and bucket n (n > 0) the ones in [2^(n-1), 2^n) us
+#define OPCODE_STATS_BUCKETS 22
+
+/// Collects call count and handler latency of every client opcode
+/// Samples are only added from the world thread (session updates), so no locking is done
+class OpcodeStatsMgr
+{
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        struct OpcodeStat
+        {
+            OpcodeStat() : count(0), totalTime(0), maxTime(0), buckets() {}
+
+            uint64 count;
+            uint64 totalTime;                               // in microseconds
+            uint64 maxTime;                                 // in microseconds
+            uint64 buckets[OPCODE_STATS_BUCKETS];
+        };
+
+        OpcodeStatsMgr();
+
+        bool IsEnabled() const { return m_enabled; }
+        void SetEnabled(bool enabled) { m_enabled = enabled; }
+
+        // file name is relative to LogsDir, the format is selected from the extension (.json, anything else is csv)
+        void SetDumpFile(std::string const& fileName);
+        std::string const& GetDumpFile() const { return m_dumpFile; }
+
+        void AddSample(uint16 opcode, Clock::duration elapsed);
+        void Reset();
+
+        OpcodeStat const& GetStat(uint16 opcode) const { return m_stats[opcode]; }
+        Clock::time_point GetStartTime() const { return m_startTime; }
+
+        // fills opcodes ordered by total time spent in their handler, only opcodes that were received are returned
+        void GetTopOpcodes(std::vector<uint16>& opcodes, uint32 limit) const;
+
+        // returns the upper bound of the bucket the percentile falls into, in microseconds
+        static uint64 GetPercentile(OpcodeStat const& stat, float percentile);
+
+        // writes all collected data to the dump file, returns false if it can't be opened
+        bool Dump() const;
+
+    private:
+        void DumpCsv(FILE* file) const;
+        void DumpJson(FILE* file) const;
+
+        std::vector<OpcodeStat> m_stats;
+        Clock::time_point m_startTime;
+        std::string m_dumpFile;
+        bool m_enabled;
+};
+
+#define sOpcodeStats MaNGOS::Singleton<OpcodeStatsMgr>::Instance()
+
+#endif
+/// @}
@@ -36,6 +36,7 @@
 #include "BattleGround/BattleGroundMgr.h"
 #include "Social/SocialMgr.h"
 #include "Loot/LootMgr.h"
+#include "Server/OpcodeStats.h"
 
 #include <mutex>
 #include <deque>
@@ -207,15 +208,38 @@ void WorldSession::LogUnprocessedTail(WorldPacket const& packet) const
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(PacketFilter& updater)
 {
-    std::lock_guard<std::mutex> guard(m_recvQueueLock);
+    ///- Take all received packets at once, the network thread must not wait while they are processed
+    {
+        std::lock_guard<std::mutex> guard(m_recvQueueLock);
+        if (m_processQueue.empty())
+            m_processQueue.swap(m_recvQueue);
+        else
+        {
+            for (auto& packet : m_recvQueue)
+                m_processQueue.push_back(std::move(packet));
+            m_recvQueue.clear();
+        }
+    }
+
+    uint32 packetBudget = sWorld.getConfig(CONFIG_UINT32_SESSION_PACKET_BUDGET);
+    uint32 timeBudget = sWorld.getConfig(CONFIG_UINT32_SESSION_PACKET_TIME_BUDGET);
+    uint32 startTime = WorldTimer::getMSTime();
+    uint32 processed = 0;
 
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
-    while (m_Socket && !m_Socket->IsClosed() && !m_recvQueue.empty())
+    while (m_Socket && !m_Socket->IsClosed() && !m_processQueue.empty())
     {
+        // a flooding client can't stall the update, the remaining packets wait for the next one
+        if (processed && ((packetBudget && processed >= packetBudget) ||
+                          (timeBudget && WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()) >= timeBudget)))
+            break;
+
+        ++processed;
+
         //取出队列头第一个消息
-        auto const packet = std::move(m_recvQueue.front());
-        m_recvQueue.pop_front();
+        auto const packet = std::move(m_processQueue.front());
+        m_processQueue.pop_front();
 
         /*#if 1
         sLog.outError( "MOEP: %s (0x%.4X)",
@@ -805,6 +829,10 @@ void WorldSession::SendTransferAborted(uint32 mapid, uint8 reason, uint8 arg) co
 
 void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet)
 {
+    bool const collectStats = sOpcodeStats.IsEnabled();
+    uint16 const opcode = packet.GetOpcode();
+    OpcodeStatsMgr::Clock::time_point const startTime = collectStats ? OpcodeStatsMgr::Clock::now() : OpcodeStatsMgr::Clock::time_point();
+
     // need prevent do internal far teleports in handlers because some handlers do lot steps
     // or call code that can do far teleports in some conditions unexpectedly for generic way work code
     if (_player)
@@ -823,6 +851,9 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& pac
             _player->TeleportTo(_player->m_teleport_dest, _player->m_teleport_options);
     }
 
+    if (collectStats)
+        sOpcodeStats.AddSample(opcode, OpcodeStatsMgr::Clock::now() - startTime);
+
     if (packet.rpos() < packet.wpos() && sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
         LogUnprocessedTail(packet);
 }
@@ -780,7 +780,8 @@ class WorldSession
         TutorialDataState m_tutorialState;
 
         std::mutex m_recvQueueLock;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueue;
+        std::deque<std::unique_ptr<WorldPacket>> m_recvQueue;      // filled by the network thread
+        std::deque<std::unique_ptr<WorldPacket>> m_processQueue;   // packets taken from m_recvQueue, only used in Update()
 };
 #endif
 /// @}
@@ -72,6 +72,7 @@ struct FriendInfo
 
 typedef std::map<uint32, FriendInfo> PlayerSocialMap;
 typedef std::map<uint32, PlayerSocial> SocialMap;
+typedef std::unordered_map<uint32, std::unordered_set<uint32> > FriendListersMap;
 
 /// Results of friend related commands
 enum FriendsResult
@@ -136,7 +137,11 @@ class SocialMgr
         SocialMgr();
         ~SocialMgr();
         // Misc
-        void RemovePlayerSocial(uint32 guid) { m_socialMap.erase(guid); }
+        void RemovePlayerSocial(uint32 guid);
+
+        // reverse index of the loaded (online players) friend lists
+        void AddFriendLister(uint32 friendGuid, uint32 listerGuid) { m_friendListers[friendGuid].insert(listerGuid); }
+        void RemoveFriendLister(uint32 friendGuid, uint32 listerGuid);
 
         void GetFriendInfo(Player* player, uint32 friendGUID, FriendInfo& friendInfo) const;
         // Packet management
@@ -147,6 +152,7 @@ class SocialMgr
         PlayerSocial* LoadFromDB(QueryResult* result, ObjectGuid guid);
     private:
         SocialMap m_socialMap;
+        FriendListersMap m_friendListers;                   // player -> loaded players having him in their friend list
 };
 
 #define sSocialMgr MaNGOS::Singleton<SocialMgr>::Instance()
@@ -319,7 +319,9 @@ void SpellLog::SendToSet()
 // ***********
 
 Spell::Spell(Unit* caster, SpellEntry const* info, uint32 triggeredFlags, ObjectGuid originalCasterGUID, SpellEntry const* triggeredBy) :
-    m_spellLog(this)
+    m_UniqueTargetInfo(TargetList::allocator_type(m_arena)), m_UniqueGOTargetInfo(GOTargetList::allocator_type(m_arena)),
+    m_UniqueItemInfo(ItemTargetList::allocator_type(m_arena)), m_TriggerSpells(SpellInfoList::allocator_type(m_arena)),
+    m_preCastSpells(SpellInfoList::allocator_type(m_arena)), m_spellLog(this)
 {
     MANGOS_ASSERT(caster != nullptr && info != nullptr);
     MANGOS_ASSERT(info == sSpellTemplate.LookupEntry<SpellEntry>(info->Id) && "`info` must be pointer to sSpellTemplate element");
@@ -7218,7 +7220,9 @@ SpellCastResult Spell::CanOpenLock(SpellEffectIndex effIndex, uint32 lockId, Ski
 void Spell::FillAreaTargets(UnitList& targetUnitMap, float radius, SpellNotifyPushType pushType, SpellTargets spellTargets, WorldObject* originalCaster /*=nullptr*/)
 {
     MaNGOS::SpellNotifierCreatureAndPlayer notifier(*this, targetUnitMap, radius, pushType, spellTargets, originalCaster);
-    Cell::VisitAllObjects(notifier.GetCenterX(), notifier.GetCenterY(), m_caster->GetMap(), notifier, radius);
+    // all push types check 2d or 3d distance to the center, so the 2d prefilter of the cell positions never drops a valid target
+    // (widened a bit so float rounding of the exact checks can't make a difference)
+    Cell::VisitUnitsInRange(notifier.GetCenterX(), notifier.GetCenterY(), m_caster->GetMap(), notifier, radius, notifier.GetCenterRadius() + 0.01f);
 }
 
 void Spell::FillRaidOrPartyTargets(UnitList& targetUnitMap, Unit* member, float radius, bool raid, bool withPets, bool withcaster) const
@@ -27,6 +27,7 @@
 #include "Entities/Unit.h"
 #include "Entities/Player.h"
 #include "Server/SQLStorages.h"
+#include "Spells/SpellArena.h"
 
 class WorldSession;
 class WorldPacket;
@@ -273,6 +274,7 @@ class Spell
         friend struct MaNGOS::SpellNotifierCreatureAndPlayer;
         friend void Unit::SetCurrentCastedSpell(Spell* pSpell);
     public:
+        DECLARE_SLAB_ALLOCATED(GetSpellAllocator)
 
         void EffectEmpty(SpellEffectIndex eff_idx);
         void EffectNULL(SpellEffectIndex eff_idx);
@@ -625,6 +627,8 @@ class Spell
         // Spell target subsystem
         //*****************************************
         // Targets store structures and data
+        SpellArena m_arena;                                 // must stay before all containers allocating from it
+
         struct TargetInfo
         {
             ObjectGuid targetGUID;
@@ -652,9 +656,9 @@ class Spell
             uint8 effectMask;
         };
 
-        typedef std::list<TargetInfo>     TargetList;
-        typedef std::list<GOTargetInfo>   GOTargetList;
-        typedef std::list<ItemTargetInfo> ItemTargetList;
+        typedef std::list<TargetInfo, SpellArenaAllocator<TargetInfo> >         TargetList;
+        typedef std::list<GOTargetInfo, SpellArenaAllocator<GOTargetInfo> >     GOTargetList;
+        typedef std::list<ItemTargetInfo, SpellArenaAllocator<ItemTargetInfo> > ItemTargetList;
 
         TargetList     m_UniqueTargetInfo;
         GOTargetList   m_UniqueGOTargetInfo;
@@ -677,7 +681,7 @@ class Spell
         // -------------------------------------------
 
         // List For Triggered Spells
-        typedef std::list<SpellEntry const*> SpellInfoList;
+        typedef std::list<SpellEntry const*, SpellArenaAllocator<SpellEntry const*> > SpellInfoList;
         SpellInfoList m_TriggerSpells;                      // casted by caster to same targets settings in m_targets at success finish of current spell
         SpellInfoList m_preCastSpells;                      // casted by caster to each target at spell hit before spell effects apply
 
@@ -764,14 +768,17 @@ namespace MaNGOS
         float i_centerX;
         float i_centerY;
         float i_centerZ;
+        float i_centerRadius;                               // bounding radius the range checks add for the center
 
         float GetCenterX() const { return i_centerX; }
         float GetCenterY() const { return i_centerY; }
+        float GetCenterRadius() const { return i_centerRadius; }
 
         SpellNotifierCreatureAndPlayer(Spell& spell, Spell::UnitList& data, float radius, SpellNotifyPushType type,
                                        SpellTargets TargetType = SPELL_TARGETS_AOE_ATTACKABLE, WorldObject* originalCaster = nullptr)
             : i_data(&data), i_spell(spell), i_push_type(type), i_radius(radius), i_TargetType(TargetType),
-              i_originalCaster(originalCaster), i_castingObject(i_spell.GetCastingObject())
+              i_originalCaster(originalCaster), i_castingObject(i_spell.GetCastingObject()),
+              i_centerX(0.0f), i_centerY(0.0f), i_centerZ(0.0f), i_centerRadius(0.0f)
         {
             if (!i_originalCaster)
                 i_originalCaster = i_spell.GetAffectiveCasterObject();
@@ -802,6 +809,7 @@ namespace MaNGOS
                     {
                         i_centerX = target->GetPositionX();
                         i_centerY = target->GetPositionY();
+                        i_centerRadius = target->GetObjectBoundingRadius();
                     }
                     break;
                 default:
@@ -810,79 +818,82 @@ namespace MaNGOS
         }
 
         template<class T> inline void Visit(GridRefManager<T>&  m)
+        {
+            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+                VisitUnit(itr->getSource());
+        }
+
+        void VisitUnit(Unit* unit)
         {
             MANGOS_ASSERT(i_data);
 
             if (!i_originalCaster || !i_castingObject)
                 return;
 
-            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+            // there are still more spells which can be casted on dead, but
+            // they are no AOE and don't have such a nice SPELL_ATTR flag
+            // mostly phase check
+            if (!unit->IsInMap(i_originalCaster) || unit->IsTaxiFlying())
+                return;
+
+            switch (i_TargetType)
             {
-                // there are still more spells which can be casted on dead, but
-                // they are no AOE and don't have such a nice SPELL_ATTR flag
-                // mostly phase check
-                if (!itr->getSource()->IsInMap(i_originalCaster) || itr->getSource()->IsTaxiFlying())
-                    continue;
+                case SPELL_TARGETS_ASSISTABLE:
+                    if (unit->GetTypeId() == TYPEID_UNIT && ((Creature*)unit)->IsTotem())
+                        return;
 
-                switch (i_TargetType)
+                    if (!i_originalCaster->CanAssistSpell(unit, i_spell.m_spellInfo))
+                        return;
+                    break;
+                case SPELL_TARGETS_AOE_ATTACKABLE:
                 {
-                    case SPELL_TARGETS_ASSISTABLE:
-                        if (itr->getSource()->GetTypeId() == TYPEID_UNIT && ((Creature*)itr->getSource())->IsTotem())
-                            continue;
-
-                        if (!i_originalCaster->CanAssistSpell(itr->getSource(), i_spell.m_spellInfo))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_AOE_ATTACKABLE:
-                    {
-                        if (itr->getSource()->GetTypeId() == TYPEID_UNIT && ((Creature*)itr->getSource())->IsTotem())
-                            continue;
+                    if (unit->GetTypeId() == TYPEID_UNIT && ((Creature*)unit)->IsTotem())
+                        return;
 
-                        if (!i_originalCaster->CanAttackSpell(itr->getSource(), i_spell.m_spellInfo, true))
-                            continue;
-                    }
-                    break;
-                    case SPELL_TARGETS_ALL:
-                        break;
-                    default: continue;
+                    if (!i_originalCaster->CanAttackSpell(unit, i_spell.m_spellInfo, true))
+                        return;
                 }
+                break;
+                case SPELL_TARGETS_ALL:
+                    break;
+                default: return;
+            }
 
-                // we don't need to check InMap here, it's already done some lines above
-                switch (i_push_type)
-                {
-                    case PUSH_IN_FRONT:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F)) //should only be 180 degrees NOT 120 degrees
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_90:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F / 2))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_60:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F / 3))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_15:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F / 12))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_BACK_90:
-                        if (i_castingObject->isInBack((Unit*)(itr->getSource()), i_radius, M_PI_F / 2))  //only used for tail swipe in TBC afaik, and that should be 90 degrees in the back
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_SELF_CENTER:
-                        if (itr->getSource()->IsWithinDist2d(i_centerX, i_centerY, i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_DEST_CENTER:
-                        if (itr->getSource()->IsWithinDist3d(i_centerX, i_centerY, i_centerZ, i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_TARGET_CENTER:
-                        if (i_spell.m_targets.getUnitTarget() && i_spell.m_targets.getUnitTarget()->IsWithinDist((Unit*)(itr->getSource()), i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                }
+            // we don't need to check InMap here, it's already done some lines above
+            switch (i_push_type)
+            {
+                case PUSH_IN_FRONT:
+                    if (i_castingObject->isInFront(unit, i_radius, M_PI_F)) //should only be 180 degrees NOT 120 degrees
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_IN_FRONT_90:
+                    if (i_castingObject->isInFront(unit, i_radius, M_PI_F / 2))
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_IN_FRONT_60:
+                    if (i_castingObject->isInFront(unit, i_radius, M_PI_F / 3))
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_IN_FRONT_15:
+                    if (i_castingObject->isInFront(unit, i_radius, M_PI_F / 12))
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_IN_BACK_90:
+                    if (i_castingObject->isInBack(unit, i_radius, M_PI_F / 2))  //only used for tail swipe in TBC afaik, and that should be 90 degrees in the back
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_SELF_CENTER:
+                    if (unit->IsWithinDist2d(i_centerX, i_centerY, i_radius))
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_DEST_CENTER:
+                    if (unit->IsWithinDist3d(i_centerX, i_centerY, i_centerZ, i_radius))
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_TARGET_CENTER:
+                    if (i_spell.m_targets.getUnitTarget() && i_spell.m_targets.getUnitTarget()->IsWithinDist(unit, i_radius))
+                        i_data->push_back(unit);
+                    break;
             }
         }
 
@@ -907,6 +918,8 @@ typedef void(Spell::*pEffect)(SpellEffectIndex eff_idx);
 class SpellEvent : public BasicEvent
 {
     public:
+        DECLARE_SLAB_ALLOCATED(GetSpellEventAllocator)
+
         SpellEvent(Spell* spell);
         virtual ~SpellEvent();
 
@@ -0,0 +1,78 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Spells/SpellArena.h"
+
+SpellArena::~SpellArena()
+{
+    while (m_chunks)
+    {
+        Chunk* next = m_chunks->next;
+        ::operator delete(m_chunks);
+        m_chunks = next;
+    }
+}
+
+void* SpellArena::Allocate(size_t size)
+{
+    size_t blockSize = GetBlockSize(size);
+    if (blockSize > MaxPooledSize)
+        return ::operator new(size);
+
+    FreeBlock*& freeList = m_freeLists[blockSize / Alignment - 1];
+    if (freeList)
+    {
+        FreeBlock* block = freeList;
+        freeList = block->next;
+        return block;
+    }
+
+    if (m_used + blockSize > m_currentSize)
+    {
+        // the rest of the current block is too small, start a new chunk (its header takes the first aligned slot)
+        Chunk* chunk = static_cast<Chunk*>(::operator new(SPELL_ARENA_CHUNK_SIZE));
+        chunk->next = m_chunks;
+        m_chunks = chunk;
+
+        m_current = reinterpret_cast<char*>(chunk);
+        m_currentSize = SPELL_ARENA_CHUNK_SIZE;
+        m_used = GetBlockSize(sizeof(Chunk));
+    }
+
+    void* block = m_current + m_used;
+    m_used += blockSize;
+    return block;
+}
+
+void SpellArena::Free(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    size_t blockSize = GetBlockSize(size);
+    if (blockSize > MaxPooledSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeBlock*& freeList = m_freeLists[blockSize / Alignment - 1];
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = freeList;
+    freeList = block;
+}
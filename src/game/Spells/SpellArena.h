@@ -0,0 +1,95 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SPELL_ARENA_H
+#define MANGOS_SPELL_ARENA_H
+
+#include "Common.h"
+
+#include <cstddef>
+
+/// Size of the block stored in every Spell, enough for the targets of a typical single target or small group spell
+#define SPELL_ARENA_INLINE_SIZE     512
+/// Size of the blocks added when a spell needs more (AoE on many targets)
+#define SPELL_ARENA_CHUNK_SIZE      4096
+
+/// Memory of one spell cast, used for its target lists and other small per cast data
+/// Freed blocks are reused for allocations of the same size, all memory is released at once with the spell
+class SpellArena
+{
+    public:
+        SpellArena() : m_current(m_inline), m_currentSize(SPELL_ARENA_INLINE_SIZE), m_used(0), m_chunks(nullptr), m_freeLists() {}
+        ~SpellArena();
+
+        SpellArena(SpellArena const&) = delete;
+        SpellArena& operator=(SpellArena const&) = delete;
+
+        void* Allocate(size_t size);
+        void Free(void* ptr, size_t size);
+
+    private:
+        static size_t const Alignment = alignof(std::max_align_t);
+        // blocks up to this size are kept in free lists, bigger ones are taken from the heap directly
+        static size_t const MaxPooledSize = 256;
+
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        struct Chunk
+        {
+            Chunk* next;
+        };
+
+        static size_t GetBlockSize(size_t size) { return (std::max(size, sizeof(FreeBlock)) + Alignment - 1) & ~(Alignment - 1); }
+
+        alignas(std::max_align_t) char m_inline[SPELL_ARENA_INLINE_SIZE];
+        char* m_current;                                    // block allocations are currently cut from
+        size_t m_currentSize;
+        size_t m_used;
+        Chunk* m_chunks;                                    // overflow chunks, released in destructor
+        FreeBlock* m_freeLists[MaxPooledSize / Alignment];
+};
+
+/// Standard allocator interface for containers owned by a spell
+template<typename T>
+class SpellArenaAllocator
+{
+    public:
+        typedef T value_type;
+
+        explicit SpellArenaAllocator(SpellArena& arena) : m_arena(&arena) {}
+        template<typename U>
+        SpellArenaAllocator(SpellArenaAllocator<U> const& other) : m_arena(other.GetArena()) {}
+
+        T* allocate(size_t count) { return static_cast<T*>(m_arena->Allocate(count * sizeof(T))); }
+        void deallocate(T* ptr, size_t count) { m_arena->Free(ptr, count * sizeof(T)); }
+
+        SpellArena* GetArena() const { return m_arena; }
+
+        template<typename U>
+        bool operator==(SpellArenaAllocator<U> const& other) const { return m_arena == other.GetArena(); }
+        template<typename U>
+        bool operator!=(SpellArenaAllocator<U> const& other) const { return m_arena != other.GetArena(); }
+
+    private:
+        SpellArena* m_arena;
+};
+
+#endif
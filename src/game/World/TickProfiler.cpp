@@ -0,0 +1,206 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/TickProfiler.h"
+#include "Maps/Map.h"
+#include "Maps/MapManager.h"
+#include "Config/Config.h"
+#include "Log.h"
+
+#include <algorithm>
+
+INSTANTIATE_SINGLETON_1(TickProfiler);
+
+static char const* const worldPhaseNames[WORLD_PHASE_COUNT + 1] =
+{
+    "sessions", "maps", "battlegrounds", "outdoorpvp", "resultqueue", "removelist", "terrain", "total"
+};
+
+static char const* const mapPhaseNames[MAP_PHASE_COUNT + 1] =
+{
+    "sessions", "players", "cells", "repath", "objectupdates", "grids", "scripts", "instance", "spawns", "total"
+};
+
+void TickTimings::StartTick()
+{
+    m_ticking = sTickProfiler.IsEnabled();
+    if (!m_ticking)
+        return;
+
+    if (m_samples.empty())
+    {
+        m_current.resize(m_phaseCount + 1);
+        m_samples.resize((m_phaseCount + 1) * TICK_PROFILER_SAMPLES);
+    }
+
+    std::fill(m_current.begin(), m_current.end(), 0);
+    m_tickStart = Clock::now();
+}
+
+void TickTimings::AddPhaseTime(uint32 phase, Clock::duration elapsed)
+{
+    m_current[phase] += uint32(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+void TickTimings::FinishTick(uint32 budget)
+{
+    if (!m_ticking)
+        return;
+
+    m_ticking = false;
+    m_current[m_phaseCount] = uint32(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_tickStart).count());
+
+    for (uint32 i = 0; i <= m_phaseCount; ++i)
+        m_samples[i * TICK_PROFILER_SAMPLES + m_position] = m_current[i];
+
+    m_position = (m_position + 1) % TICK_PROFILER_SAMPLES;
+    if (m_sampleCount < TICK_PROFILER_SAMPLES)
+        ++m_sampleCount;
+
+    if (budget && m_current[m_phaseCount] > budget * IN_MILLISECONDS)
+        ++m_slowTicks;
+}
+
+void TickTimings::GetPhaseStats(uint32 phase, uint32& p50, uint32& p99, uint32& max) const
+{
+    p50 = p99 = max = 0;
+    if (!m_sampleCount)
+        return;
+
+    // samples are only appended at the end until the buffer is full, so the first m_sampleCount are valid
+    std::vector<uint32>::const_iterator begin = m_samples.begin() + phase * TICK_PROFILER_SAMPLES;
+    std::vector<uint32> sorted(begin, begin + m_sampleCount);
+
+    std::vector<uint32>::iterator p50Itr = sorted.begin() + sorted.size() / 2;
+    std::nth_element(sorted.begin(), p50Itr, sorted.end());
+    p50 = *p50Itr;
+
+    std::vector<uint32>::iterator p99Itr = sorted.begin() + sorted.size() * 99 / 100;
+    std::nth_element(p50Itr, p99Itr, sorted.end());
+    p99 = *p99Itr;
+
+    max = *std::max_element(p99Itr, sorted.end());
+}
+
+void TickProfiler::SetDumpFile(std::string const& fileName)
+{
+    m_dumpFile.clear();
+    if (fileName.empty())
+        return;
+
+    m_dumpFile = sConfig.GetStringDefault("LogsDir");
+    if (!m_dumpFile.empty() && m_dumpFile.back() != '/' && m_dumpFile.back() != '\\')
+        m_dumpFile.append("/");
+
+    m_dumpFile.append(fileName);
+}
+
+char const* TickProfiler::GetWorldPhaseName(uint32 phase)
+{
+    return phase <= WORLD_PHASE_COUNT ? worldPhaseNames[phase] : "";
+}
+
+char const* TickProfiler::GetMapPhaseName(uint32 phase)
+{
+    return phase <= MAP_PHASE_COUNT ? mapPhaseNames[phase] : "";
+}
+
+void TickProfiler::GetSlowestMaps(std::vector<Map*>& maps, uint32 limit) const
+{
+    std::vector<std::pair<uint32, Map*> > sorted;
+    for (MapManager::MapMapType::const_iterator itr = sMapMgr.Maps().begin(); itr != sMapMgr.Maps().end(); ++itr)
+    {
+        TickTimings const& timings = itr->second->GetTickTimings();
+        if (!timings.GetSampleCount())
+            continue;
+
+        uint32 p50, p99, max;
+        timings.GetPhaseStats(MAP_PHASE_COUNT, p50, p99, max);
+        sorted.push_back(std::make_pair(p99, itr->second));
+    }
+
+    std::sort(sorted.begin(), sorted.end(), [](std::pair<uint32, Map*> const& a, std::pair<uint32, Map*> const& b) { return a.first > b.first; });
+    if (limit && sorted.size() > limit)
+        sorted.resize(limit);
+
+    maps.clear();
+    for (auto const& itr : sorted)
+        maps.push_back(itr.second);
+}
+
+void TickProfiler::Report()
+{
+    uint32 p50, p99, max;
+    m_worldTimings.GetPhaseStats(WORLD_PHASE_COUNT, p50, p99, max);
+    sLog.outString("TickProfiler: world update p50 %u us, p99 %u us, max %u us over %u ticks", p50, p99, max, m_worldTimings.GetSampleCount());
+
+    for (MapManager::MapMapType::const_iterator itr = sMapMgr.Maps().begin(); itr != sMapMgr.Maps().end(); ++itr)
+    {
+        Map* map = itr->second;
+        TickTimings& timings = map->GetTickTimings();
+        if (!timings.GetSlowTicks())
+            continue;
+
+        timings.GetPhaseStats(MAP_PHASE_COUNT, p50, p99, max);
+        sLog.outString("TickProfiler: map %u (%s) instance %u was over the %u ms budget in %u ticks, p50 %u us, p99 %u us, max %u us",
+                       map->GetId(), map->GetMapName(), map->GetInstanceId(), m_mapBudget, timings.GetSlowTicks(), p50, p99, max);
+        timings.ResetSlowTicks();
+    }
+
+    if (!m_dumpFile.empty())
+        Dump();
+}
+
+bool TickProfiler::Dump() const
+{
+    if (m_dumpFile.empty())
+        return false;
+
+    FILE* file = fopen(m_dumpFile.c_str(), "w");
+    if (!file)
+    {
+        sLog.outError("TickProfiler: can't open dump file %s", m_dumpFile.c_str());
+        return false;
+    }
+
+    fprintf(file, "scope,map,instance,phase,ticks,p50_us,p99_us,max_us\n");
+
+    uint32 p50, p99, max;
+    for (uint32 i = 0; i <= WORLD_PHASE_COUNT; ++i)
+    {
+        m_worldTimings.GetPhaseStats(i, p50, p99, max);
+        fprintf(file, "world,,,%s,%u,%u,%u,%u\n", GetWorldPhaseName(i), m_worldTimings.GetSampleCount(), p50, p99, max);
+    }
+
+    for (MapManager::MapMapType::const_iterator itr = sMapMgr.Maps().begin(); itr != sMapMgr.Maps().end(); ++itr)
+    {
+        TickTimings const& timings = itr->second->GetTickTimings();
+        if (!timings.GetSampleCount())
+            continue;
+
+        for (uint32 i = 0; i <= MAP_PHASE_COUNT; ++i)
+        {
+            timings.GetPhaseStats(i, p50, p99, max);
+            fprintf(file, "map,%u,%u,%s,%u,%u,%u,%u\n", itr->second->GetId(), itr->second->GetInstanceId(),
+                    GetMapPhaseName(i), timings.GetSampleCount(), p50, p99, max);
+        }
+    }
+
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,157 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup world
+/// @{
+/// \file
+
+#ifndef MANGOS_TICK_PROFILER_H
+#define MANGOS_TICK_PROFILER_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <chrono>
+
+class Map;
+
+/// Number of ticks kept per world/map for the percentiles
+#define TICK_PROFILER_SAMPLES 512
+
+enum WorldTickPhase
+{
+    WORLD_PHASE_SESSIONS        = 0,
+    WORLD_PHASE_MAPS            = 1,
+    WORLD_PHASE_BATTLEGROUNDS   = 2,
+    WORLD_PHASE_OUTDOORPVP      = 3,
+    WORLD_PHASE_RESULT_QUEUE    = 4,
+    WORLD_PHASE_REMOVE_LIST     = 5,
+    WORLD_PHASE_TERRAIN         = 6,
+    WORLD_PHASE_COUNT           = 7
+};
+
+enum MapTickPhase
+{
+    MAP_PHASE_SESSIONS          = 0,
+    MAP_PHASE_PLAYERS           = 1,
+    MAP_PHASE_CELLS             = 2,
+    MAP_PHASE_REPATH            = 3,
+    MAP_PHASE_OBJECT_UPDATES    = 4,
+    MAP_PHASE_GRIDS             = 5,
+    MAP_PHASE_SCRIPTS           = 6,
+    MAP_PHASE_INSTANCE          = 7,
+    MAP_PHASE_SPAWNS            = 8,
+    MAP_PHASE_COUNT             = 9
+};
+
+/// Phase durations of the last TICK_PROFILER_SAMPLES ticks of the world or of one map, in microseconds
+/// The total time of the tick is stored as an additional phase with index phaseCount
+class TickTimings
+{
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        explicit TickTimings(uint32 phaseCount) : m_phaseCount(phaseCount), m_position(0), m_sampleCount(0), m_slowTicks(0), m_ticking(false) {}
+
+        // does nothing if the profiler is disabled, the phase timers are skipped then
+        void StartTick();
+        // stores the tick, counts it as slow if it took more than budget (in milliseconds, 0 to not check)
+        void FinishTick(uint32 budget = 0);
+
+        bool IsTicking() const { return m_ticking; }
+        void AddPhaseTime(uint32 phase, Clock::duration elapsed);
+
+        uint32 GetPhaseCount() const { return m_phaseCount; }
+        uint32 GetSampleCount() const { return m_sampleCount; }
+        void GetPhaseStats(uint32 phase, uint32& p50, uint32& p99, uint32& max) const;
+
+        uint32 GetSlowTicks() const { return m_slowTicks; }
+        void ResetSlowTicks() { m_slowTicks = 0; }
+
+    private:
+        uint32 m_phaseCount;
+        std::vector<uint32> m_current;                      // phase times of the running tick
+        std::vector<uint32> m_samples;                      // ring buffer per phase, allocated at first profiled tick
+        uint32 m_position;
+        uint32 m_sampleCount;
+        uint32 m_slowTicks;
+        Clock::time_point m_tickStart;
+        bool m_ticking;
+};
+
+/// Adds the time spent in its scope to a phase of the running tick
+class TickPhaseTimer
+{
+    public:
+        TickPhaseTimer(TickTimings& timings, uint32 phase) : m_timings(timings.IsTicking() ? &timings : nullptr), m_phase(phase)
+        {
+            if (m_timings)
+                m_start = TickTimings::Clock::now();
+        }
+
+        ~TickPhaseTimer()
+        {
+            if (m_timings)
+                m_timings->AddPhaseTime(m_phase, TickTimings::Clock::now() - m_start);
+        }
+
+    private:
+        TickTimings* m_timings;
+        uint32 m_phase;
+        TickTimings::Clock::time_point m_start;
+};
+
+class TickProfiler
+{
+    public:
+        TickProfiler() : m_worldTimings(WORLD_PHASE_COUNT), m_mapBudget(0), m_enabled(false) {}
+
+        bool IsEnabled() const { return m_enabled; }
+        void SetEnabled(bool enabled) { m_enabled = enabled; }
+
+        uint32 GetMapBudget() const { return m_mapBudget; }
+        void SetMapBudget(uint32 budget) { m_mapBudget = budget; }
+
+        // file name is relative to LogsDir
+        void SetDumpFile(std::string const& fileName);
+        std::string const& GetDumpFile() const { return m_dumpFile; }
+
+        TickTimings& GetWorldTimings() { return m_worldTimings; }
+
+        static char const* GetWorldPhaseName(uint32 phase);
+        static char const* GetMapPhaseName(uint32 phase);
+
+        // fills the loaded maps ordered by the 99th percentile of their tick time
+        void GetSlowestMaps(std::vector<Map*>& maps, uint32 limit) const;
+
+        // logs the world tick times and the maps over budget since the last report, and writes the dump file
+        void Report();
+        // writes the times of all phases of the world and all loaded maps in csv format
+        bool Dump() const;
+
+    private:
+        TickTimings m_worldTimings;
+        std::string m_dumpFile;
+        uint32 m_mapBudget;
+        bool m_enabled;
+};
+
+#define sTickProfiler MaNGOS::Singleton<TickProfiler>::Instance()
+
+#endif
+/// @}
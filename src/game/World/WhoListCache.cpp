@@ -0,0 +1,126 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/WhoListCache.h"
+#include "Globals/ObjectAccessor.h"
+#include "Guilds/GuildMgr.h"
+#include "Entities/Player.h"
+#include "Server/DBCEnums.h"
+
+#include <algorithm>
+
+INSTANTIATE_SINGLETON_1(WhoListCache);
+
+WhoListCache::WhoListCache() : m_levelStart(STRONG_MAX_LEVEL + 2, 0)
+{
+}
+
+void WhoListCache::Refresh()
+{
+    m_players.clear();
+    m_zoneIndex.clear();
+
+    {
+        HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
+        HashMapHolder<Player>::MapType const& players = sObjectAccessor.GetPlayers();
+        m_players.reserve(players.size());
+
+        for (HashMapHolder<Player>::MapType::const_iterator itr = players.begin(); itr != players.end(); ++itr)
+        {
+            Player* pl = itr->second;
+            if (!pl->IsInWorld())
+                continue;
+
+            WhoListPlayerInfo info;
+            info.guid = pl->GetObjectGuid();
+            info.name = pl->GetName();
+            info.guildName = sGuildMgr.GetGuildNameById(pl->GetGuildId());
+            if (!Utf8toWStr(info.name, info.wname) || !Utf8toWStr(info.guildName, info.wguildName))
+                continue;
+
+            wstrToLower(info.wname);
+            wstrToLower(info.wguildName);
+            info.level = std::min(pl->getLevel(), uint32(STRONG_MAX_LEVEL));
+            info.zoneId = pl->GetZoneId();
+            info.class_ = pl->getClass();
+            info.race = pl->getRace();
+            info.gender = pl->getGender();
+            info.classMask = 1 << info.class_;
+            info.raceMask = 1 << info.race;
+            info.team = pl->GetTeam();
+            info.security = pl->GetSession()->GetSecurity();
+            m_players.push_back(info);
+        }
+    }
+
+    std::stable_sort(m_players.begin(), m_players.end(), [](WhoListPlayerInfo const& a, WhoListPlayerInfo const& b) { return a.level < b.level; });
+
+    uint32 level = 0;
+    for (uint32 i = 0; i < m_players.size(); ++i)
+    {
+        while (level <= m_players[i].level)
+            m_levelStart[level++] = i;
+
+        m_zoneIndex[m_players[i].zoneId].push_back(i);
+    }
+
+    while (level < m_levelStart.size())
+        m_levelStart[level++] = m_players.size();
+}
+
+void WhoListCache::GetPlayers(uint32 levelMin, uint32 levelMax, uint32 classMask, uint32 raceMask,
+                              uint32 const* zoneIds, uint32 zonesCount, PlayerInfoList& result) const
+{
+    result.clear();
+
+    levelMax = std::min(levelMax, uint32(STRONG_MAX_LEVEL));
+    if (levelMin > levelMax)
+        return;
+
+    if (!zonesCount)
+    {
+        for (uint32 i = m_levelStart[levelMin]; i < m_levelStart[levelMax + 1]; ++i)
+        {
+            WhoListPlayerInfo const& info = m_players[i];
+            if ((info.classMask & classMask) && (info.raceMask & raceMask))
+                result.push_back(&info);
+        }
+        return;
+    }
+
+    for (uint32 z = 0; z < zonesCount; ++z)
+    {
+        // same zone requested twice
+        if (std::find(zoneIds, zoneIds + z, zoneIds[z]) != zoneIds + z)
+            continue;
+
+        ZoneIndexMap::const_iterator zone = m_zoneIndex.find(zoneIds[z]);
+        if (zone == m_zoneIndex.end())
+            continue;
+
+        for (uint32 i : zone->second)
+        {
+            WhoListPlayerInfo const& info = m_players[i];
+            if (info.level < levelMin || info.level > levelMax)
+                continue;
+
+            if ((info.classMask & classMask) && (info.raceMask & raceMask))
+                result.push_back(&info);
+        }
+    }
+}
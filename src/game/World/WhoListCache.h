@@ -0,0 +1,77 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup world
+/// @{
+/// \file
+
+#ifndef MANGOS_WHO_LIST_CACHE_H
+#define MANGOS_WHO_LIST_CACHE_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+#include "Entities/ObjectGuid.h"
+#include "Globals/SharedDefines.h"
+
+/// Data of an online player shown in the /who list, as it was at the last refresh
+struct WhoListPlayerInfo
+{
+    ObjectGuid guid;
+    std::string name;
+    std::string guildName;
+    std::wstring wname;                                     // lower case, for the substring searches
+    std::wstring wguildName;
+    uint32 level;
+    uint32 zoneId;
+    uint32 classMask;
+    uint32 raceMask;
+    uint8 class_;
+    uint8 race;
+    uint8 gender;
+    Team team;
+    AccountTypes security;
+};
+
+/// Snapshot of the online players ordered by level and indexed by zone, so /who requests
+/// don't walk the player map and don't convert every name and guild name for each request
+class WhoListCache
+{
+    public:
+        typedef std::vector<WhoListPlayerInfo const*> PlayerInfoList;
+
+        WhoListCache();
+
+        // rebuilds the snapshot from the players in world
+        void Refresh();
+
+        // fills the players with level in range, class/race in the masks and in one of the zones (any zone if zonesCount is 0)
+        void GetPlayers(uint32 levelMin, uint32 levelMax, uint32 classMask, uint32 raceMask,
+                        uint32 const* zoneIds, uint32 zonesCount, PlayerInfoList& result) const;
+
+    private:
+        typedef std::unordered_map<uint32, std::vector<uint32> > ZoneIndexMap;
+
+        std::vector<WhoListPlayerInfo> m_players;           // ordered by level
+        std::vector<uint32> m_levelStart;                   // index of the first player with at least the level, STRONG_MAX_LEVEL + 2 entries
+        ZoneIndexMap m_zoneIndex;                           // zone -> indexes in m_players, ordered by level as well
+};
+
+#define sWhoListCache MaNGOS::Singleton<WhoListCache>::Instance()
+
+#endif
+/// @}
@@ -28,6 +28,9 @@
 #include "Log.h"
 #include "Server/Opcodes.h"
 #include "Server/WorldSession.h"
+#include "Server/OpcodeStats.h"
+#include "World/TickProfiler.h"
+#include "World/WhoListCache.h"
 #include "WorldPacket.h"
 #include "Entities/Player.h"
 #include "Skills/SkillExtraItems.h"
@@ -465,6 +468,9 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
     setConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS, "MaxWhoListReturns", 49);
+    setConfig(CONFIG_UINT32_WHO_LIST_REFRESH_INTERVAL, "WhoList.RefreshInterval", 5000);
+    m_timers[WUPDATE_WHOLIST].SetInterval(getConfig(CONFIG_UINT32_WHO_LIST_REFRESH_INTERVAL));
+    m_timers[WUPDATE_WHOLIST].Reset();
 
     std::string forceLoadGridOnMaps = sConfig.GetStringDefault("LoadAllGridsOnMaps");
     if (!forceLoadGridOnMaps.empty())
@@ -592,6 +598,22 @@ void World::LoadConfigSettings(bool reload)
         m_timers[WUPDATE_UPTIME].Reset();
     }
 
+    setConfig(CONFIG_BOOL_OPCODE_STATS, "OpcodeStats.Enable", false);
+    setConfig(CONFIG_UINT32_OPCODE_STATS_DUMP_INTERVAL, "OpcodeStats.DumpInterval", 0);
+    sOpcodeStats.SetEnabled(getConfig(CONFIG_BOOL_OPCODE_STATS));
+    sOpcodeStats.SetDumpFile(sConfig.GetStringDefault("OpcodeStats.DumpFile", "OpcodeStats.csv"));
+    m_timers[WUPDATE_OPCODESTATS].SetInterval(getConfig(CONFIG_UINT32_OPCODE_STATS_DUMP_INTERVAL) * IN_MILLISECONDS);
+    m_timers[WUPDATE_OPCODESTATS].Reset();
+
+    setConfig(CONFIG_BOOL_TICK_PROFILER, "TickProfiler.Enable", false);
+    setConfig(CONFIG_UINT32_TICK_PROFILER_MAP_BUDGET, "TickProfiler.MapBudget", 100);
+    setConfig(CONFIG_UINT32_TICK_PROFILER_REPORT_INTERVAL, "TickProfiler.ReportInterval", 60);
+    sTickProfiler.SetEnabled(getConfig(CONFIG_BOOL_TICK_PROFILER));
+    sTickProfiler.SetMapBudget(getConfig(CONFIG_UINT32_TICK_PROFILER_MAP_BUDGET));
+    sTickProfiler.SetDumpFile(sConfig.GetStringDefault("TickProfiler.DumpFile", "TickProfile.csv"));
+    m_timers[WUPDATE_TICKPROFILE].SetInterval(getConfig(CONFIG_UINT32_TICK_PROFILER_REPORT_INTERVAL) * IN_MILLISECONDS);
+    m_timers[WUPDATE_TICKPROFILE].Reset();
+
     setConfig(CONFIG_UINT32_SKILL_CHANCE_ORANGE, "SkillChance.Orange", 100);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_YELLOW, "SkillChance.Yellow", 75);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_GREEN,  "SkillChance.Green",  25);
@@ -631,6 +653,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_CHATFLOOD_MUTE_TIME,     "ChatFlood.MuteTime", 10);
 
     setConfig(CONFIG_BOOL_EVENT_ANNOUNCE, "Event.Announce", false);
+    setConfig(CONFIG_UINT32_GAME_EVENT_SPAWN_BUDGET, "Event.SpawnBudget", 5);
 
     setConfig(CONFIG_UINT32_CREATURE_FAMILY_ASSISTANCE_DELAY, "CreatureFamilyAssistanceDelay", 1500);
     setConfig(CONFIG_UINT32_CREATURE_FAMILY_FLEE_DELAY,       "CreatureFamilyFleeDelay",       7000);
@@ -709,12 +732,16 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_OFFHAND_CHECK_AT_TALENTS_RESET, "OffhandCheckAtTalentsReset", false);
 
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET, "Network.KickOnBadPacket", false);
+    setConfig(CONFIG_UINT32_SESSION_PACKET_BUDGET, "Network.PacketsPerUpdate", 100);
+    setConfig(CONFIG_UINT32_SESSION_PACKET_TIME_BUDGET, "Network.PacketsUpdateTime", 20);
 
     setConfig(CONFIG_BOOL_PLAYER_COMMANDS, "PlayerCommands", true);
 
     setConfig(CONFIG_UINT32_INSTANT_LOGOUT, "InstantLogout", SEC_MODERATOR);
 
     setConfigMin(CONFIG_UINT32_GROUP_OFFLINE_LEADER_DELAY, "Group.OfflineLeaderDelay", 300, 0);
+    setConfig(CONFIG_UINT32_GROUP_HEALTH_UPDATE_INTERVAL, "Group.HealthUpdateInterval", 500);
+    setConfig(CONFIG_UINT32_GROUP_POSITION_UPDATE_INTERVAL, "Group.PositionUpdateInterval", 1000);
 
     setConfigMin(CONFIG_UINT32_GUILD_EVENT_LOG_COUNT, "Guild.EventLogRecordsCount", GUILD_EVENTLOG_MAX_RECORDS, GUILD_EVENTLOG_MAX_RECORDS);
     setConfigMin(CONFIG_UINT32_GUILD_BANK_EVENT_LOG_COUNT, "Guild.BankEventLogRecordsCount", GUILD_BANK_MAX_LOGS, GUILD_BANK_MAX_LOGS);
@@ -783,6 +810,11 @@ void World::LoadConfigSettings(bool reload)
         m_MaxVisibleDistanceInBGArenas = MAX_VISIBILITY_DISTANCE - m_VisibleUnitGreyDistance;
     }
 
+    setConfigMin(CONFIG_FLOAT_UPDATE_LOD_DISTANCE_CONTINENTS, "UpdateLOD.Distance.Continents", 40.0f, 0.0f);
+    setConfigMin(CONFIG_FLOAT_UPDATE_LOD_DISTANCE_INSTANCES, "UpdateLOD.Distance.Instances", 0.0f, 0.0f);
+    setConfigMin(CONFIG_FLOAT_UPDATE_LOD_DISTANCE_BGARENAS, "UpdateLOD.Distance.BGArenas", 0.0f, 0.0f);
+    setConfig(CONFIG_UINT32_UPDATE_LOD_INTERVAL, "UpdateLOD.Interval", 500);
+
     m_MaxVisibleDistanceInFlight    = sConfig.GetFloatDefault("Visibility.Distance.InFlight",      DEFAULT_VISIBILITY_DISTANCE);
     if (m_MaxVisibleDistanceInFlight + m_VisibleObjectGreyDistance > MAX_VISIBILITY_DISTANCE)
     {
@@ -843,6 +875,7 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_PATH_FIND_OPTIMIZE, "PathFinder.OptimizePath", true);
     setConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z, "PathFinder.NormalizeZ", false);
+    setConfig(CONFIG_UINT32_PATH_FIND_REPATH_BUDGET, "PathFinder.RepathBudget", 100);
 
     sLog.outString();
 }
@@ -1426,6 +1459,9 @@ void World::Update(uint32 diff)
     m_currentTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
     m_currentDiff = diff;
 
+    TickTimings& tickTimings = sTickProfiler.GetWorldTimings();
+    tickTimings.StartTick();
+
     ///- Update the different timers
     for (int i = 0; i < WUPDATE_COUNT; ++i)
     {
@@ -1478,7 +1514,25 @@ void World::Update(uint32 diff)
     }
 
     /// <li> Handle session updates
-    UpdateSessions(diff);
+    {
+        TickPhaseTimer phaseTimer(tickTimings, WORLD_PHASE_SESSIONS);
+        UpdateSessions(diff);
+    }
+
+    /// <li> Write opcode handler stats
+    if (getConfig(CONFIG_UINT32_OPCODE_STATS_DUMP_INTERVAL) && m_timers[WUPDATE_OPCODESTATS].Passed())
+    {
+        m_timers[WUPDATE_OPCODESTATS].Reset();
+        if (sOpcodeStats.IsEnabled())
+            sOpcodeStats.Dump();
+    }
+
+    /// <li> Refresh the /who list snapshot
+    if (getConfig(CONFIG_UINT32_WHO_LIST_REFRESH_INTERVAL) && m_timers[WUPDATE_WHOLIST].Passed())
+    {
+        m_timers[WUPDATE_WHOLIST].Reset();
+        sWhoListCache.Refresh();
+    }
 
     /// <li> Update uptime table
     if (m_timers[WUPDATE_UPTIME].Passed())
@@ -1492,9 +1546,18 @@ void World::Update(uint32 diff)
 
     /// <li> Handle all other objects
     ///- Update objects (maps, transport, creatures,...)
-    sMapMgr.Update(diff);
-    sBattleGroundMgr.Update(diff);
-    sOutdoorPvPMgr.Update(diff);
+    {
+        TickPhaseTimer phaseTimer(tickTimings, WORLD_PHASE_MAPS);
+        sMapMgr.Update(diff);
+    }
+    {
+        TickPhaseTimer phaseTimer(tickTimings, WORLD_PHASE_BATTLEGROUNDS);
+        sBattleGroundMgr.Update(diff);
+    }
+    {
+        TickPhaseTimer phaseTimer(tickTimings, WORLD_PHASE_OUTDOORPVP);
+        sOutdoorPvPMgr.Update(diff);
+    }
     sWorldState.Update(diff);
 
     ///- Update groups with offline leaders
@@ -1516,7 +1579,10 @@ void World::Update(uint32 diff)
     }
 
     // execute callbacks from sql queries that were queued recently
-    UpdateResultQueue();
+    {
+        TickPhaseTimer phaseTimer(tickTimings, WORLD_PHASE_RESULT_QUEUE);
+        UpdateResultQueue();
+    }
 
     ///- Erase corpses once every 20 minutes
     if (m_timers[WUPDATE_CORPSES].Passed())
@@ -1537,7 +1603,10 @@ void World::Update(uint32 diff)
 
     /// </ul>
     ///- Move all creatures with "delayed move" and remove and delete all objects with "delayed remove"
-    sMapMgr.RemoveAllObjectsInRemoveList();
+    {
+        TickPhaseTimer phaseTimer(tickTimings, WORLD_PHASE_REMOVE_LIST);
+        sMapMgr.RemoveAllObjectsInRemoveList();
+    }
 
     // update the instance reset times
     sMapPersistentStateMgr.Update();
@@ -1546,7 +1615,20 @@ void World::Update(uint32 diff)
     ProcessCliCommands();
 
     // cleanup unused GridMap objects as well as VMaps
-    sTerrainMgr.Update(diff);
+    {
+        TickPhaseTimer phaseTimer(tickTimings, WORLD_PHASE_TERRAIN);
+        sTerrainMgr.Update(diff);
+    }
+
+    tickTimings.FinishTick();
+
+    ///- Log the tick times and the maps over budget
+    if (getConfig(CONFIG_UINT32_TICK_PROFILER_REPORT_INTERVAL) && m_timers[WUPDATE_TICKPROFILE].Passed())
+    {
+        m_timers[WUPDATE_TICKPROFILE].Reset();
+        if (sTickProfiler.IsEnabled())
+            sTickProfiler.Report();
+    }
 }
 
 namespace MaNGOS
@@ -76,7 +76,10 @@ enum WorldTimers
     WUPDATE_DELETECHARS = 4,
     WUPDATE_AHBOT       = 5,
     WUPDATE_GROUPS      = 6,
-    WUPDATE_COUNT       = 7
+    WUPDATE_OPCODESTATS = 7,
+    WUPDATE_TICKPROFILE = 8,
+    WUPDATE_WHOLIST     = 9,
+    WUPDATE_COUNT       = 10
 };
 
 /// Configuration elements
@@ -127,6 +130,8 @@ enum eConfigUInt32Values
     CONFIG_UINT32_GM_INVISIBLE_AURA,
     CONFIG_UINT32_MAIL_DELIVERY_DELAY,
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
+    CONFIG_UINT32_GAME_EVENT_SPAWN_BUDGET,
+    CONFIG_UINT32_UPDATE_LOD_INTERVAL,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
     CONFIG_UINT32_SKILL_CHANCE_ORANGE,
@@ -168,6 +173,8 @@ enum eConfigUInt32Values
     CONFIG_UINT32_ARENA_SEASON_ID,
     CONFIG_UINT32_ARENA_FIRST_RESET_DAY,
     CONFIG_UINT32_GROUP_OFFLINE_LEADER_DELAY,
+    CONFIG_UINT32_GROUP_HEALTH_UPDATE_INTERVAL,
+    CONFIG_UINT32_GROUP_POSITION_UPDATE_INTERVAL,
     CONFIG_UINT32_GUILD_EVENT_LOG_COUNT,
     CONFIG_UINT32_GUILD_BANK_EVENT_LOG_COUNT,
     CONFIG_UINT32_TIMERBAR_FATIGUE_GMLEVEL,
@@ -187,6 +194,13 @@ enum eConfigUInt32Values
     CONFIG_UINT32_FOGOFWAR_STEALTH,
     CONFIG_UINT32_FOGOFWAR_HEALTH,
     CONFIG_UINT32_FOGOFWAR_STATS,
+    CONFIG_UINT32_PATH_FIND_REPATH_BUDGET,
+    CONFIG_UINT32_SESSION_PACKET_BUDGET,
+    CONFIG_UINT32_SESSION_PACKET_TIME_BUDGET,
+    CONFIG_UINT32_OPCODE_STATS_DUMP_INTERVAL,
+    CONFIG_UINT32_TICK_PROFILER_MAP_BUDGET,
+    CONFIG_UINT32_TICK_PROFILER_REPORT_INTERVAL,
+    CONFIG_UINT32_WHO_LIST_REFRESH_INTERVAL,
     CONFIG_UINT32_VALUE_COUNT
 };
 
@@ -274,6 +288,9 @@ enum eConfigFloatValues
     CONFIG_FLOAT_THREAT_RADIUS,
     CONFIG_FLOAT_GHOST_RUN_SPEED_WORLD,
     CONFIG_FLOAT_GHOST_RUN_SPEED_BG,
+    CONFIG_FLOAT_UPDATE_LOD_DISTANCE_CONTINENTS,
+    CONFIG_FLOAT_UPDATE_LOD_DISTANCE_INSTANCES,
+    CONFIG_FLOAT_UPDATE_LOD_DISTANCE_BGARENAS,
     CONFIG_FLOAT_VALUE_COUNT
 };
 
@@ -343,6 +360,8 @@ enum eConfigBoolValues
     CONFIG_BOOL_PLAYER_COMMANDS,
     CONFIG_BOOL_PATH_FIND_OPTIMIZE,
     CONFIG_BOOL_PATH_FIND_NORMALIZE_Z,
+    CONFIG_BOOL_OPCODE_STATS,
+    CONFIG_BOOL_TICK_PROFILER,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -26,7 +26,12 @@
 
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <thread>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <algorithm>
 #include <cstdarg>
 
 INSTANTIATE_SINGLETON_1(Log);
@@ -64,13 +69,137 @@ enum LogType
 
 const int LogType_count = int(LogError) + 1;
 
+/// Line queued for the asynchronous log writer, the text is already formatted by the caller
+struct LogRecord
+{
+    LogRecord() : file(nullptr), account(0), time(0) {}
+
+    FILE* file;                                             // nullptr for the gm log of account
+    uint32 account;
+    time_t time;                                            // 0 to not write a timestamp
+    std::string text;                                       // reused between records, so it keeps its capacity
+};
+
+/// Bounded multi producer single consumer ring buffer of log records
+/// Producers claim a cell with one compare and swap and publish it through the cell sequence, no lock is taken
+class LogQueue
+{
+    public:
+        explicit LogQueue(size_t size) : m_cells(new Cell[size]), m_mask(size - 1), m_enqueuePos(0), m_dequeuePos(0)
+        {
+            MANGOS_ASSERT(size && !(size & (size - 1)));
+            for (size_t i = 0; i < size; ++i)
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        // returns false if the queue is full
+        bool Enqueue(FILE* file, uint32 account, time_t time, char const* prefix, char const* text)
+        {
+            Cell* cell;
+            size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &m_cells[pos & m_mask];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                intptr_t dif = intptr_t(seq) - intptr_t(pos);
+                if (dif == 0)
+                {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (dif < 0)
+                    return false;
+                else
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+
+            cell->record.file = file;
+            cell->record.account = account;
+            cell->record.time = time;
+            cell->record.text.assign(prefix);
+            cell->record.text.append(text);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // only called by one thread at a time, the record is valid until the next call
+        LogRecord const* Front() const
+        {
+            Cell& cell = m_cells[m_dequeuePos & m_mask];
+            return cell.sequence.load(std::memory_order_acquire) == m_dequeuePos + 1 ? &cell.record : nullptr;
+        }
+
+        void Pop()
+        {
+            m_cells[m_dequeuePos & m_mask].sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+            ++m_dequeuePos;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            LogRecord record;
+        };
+
+        std::unique_ptr<Cell[]> m_cells;
+        size_t const m_mask;
+        std::atomic<size_t> m_enqueuePos;
+        size_t m_dequeuePos;
+};
+
+#define LOG_QUEUE_SIZE 16384
+
 Log::Log() :
     raLogfile(nullptr), logfile(nullptr), gmLogfile(nullptr), charLogfile(nullptr), customLogFile(nullptr),
-    dberLogfile(nullptr), eventAiErLogfile(nullptr), scriptErrLogFile(nullptr), worldLogfile(nullptr), m_colored(false), m_includeTime(false), m_gmlog_per_account(false), m_scriptLibName(nullptr)
+    dberLogfile(nullptr), eventAiErLogfile(nullptr), scriptErrLogFile(nullptr), worldLogfile(nullptr), m_asyncQueue(nullptr), m_async(false), m_stopAsyncWriter(false), m_asyncProducers(0),
+    m_colored(false), m_includeTime(false), m_gmlog_per_account(false), m_scriptLibName(nullptr)
 {
     Initialize();
 }
 
+Log::~Log()
+{
+    StopAsyncWriter();
+    delete m_asyncQueue;
+
+    if (logfile != nullptr)
+        fclose(logfile);
+    logfile = nullptr;
+
+    if (gmLogfile != nullptr)
+        fclose(gmLogfile);
+    gmLogfile = nullptr;
+
+    if (charLogfile != nullptr)
+        fclose(charLogfile);
+    charLogfile = nullptr;
+
+    if (dberLogfile != nullptr)
+        fclose(dberLogfile);
+    dberLogfile = nullptr;
+
+    if (eventAiErLogfile != nullptr)
+        fclose(eventAiErLogfile);
+    eventAiErLogfile = nullptr;
+
+    if (scriptErrLogFile != nullptr)
+        fclose(scriptErrLogFile);
+    scriptErrLogFile = nullptr;
+
+    if (raLogfile != nullptr)
+        fclose(raLogfile);
+    raLogfile = nullptr;
+
+    if (worldLogfile != nullptr)
+        fclose(worldLogfile);
+    worldLogfile = nullptr;
+
+    if (customLogFile != nullptr)
+        fclose(customLogFile);
+    customLogFile = nullptr;
+}
+
 void Log::InitColors(const std::string& str)
 {
     if (str.empty())
@@ -216,6 +345,9 @@ void Log::SetLogFileLevel(char* level)
 
 void Log::Initialize()
 {
+    // files are reopened below, queued lines have to be written first
+    StopAsyncWriter();
+
     /// Common log files data
     //ȡ־Ŀ¼, ĬֵΪ""
     m_logsDir = sConfig.GetStringDefault("LogsDir");
@@ -291,6 +423,10 @@ void Log::Initialize()
 
     // Char log settings
     m_charLog_Dump = sConfig.GetBoolDefault("CharLogDump", false);
+
+    // file output moved to a writer thread
+    if (sConfig.GetBoolDefault("LogAsync", true))
+        StartAsyncWriter();
 }
 
 FILE* Log::openLogFile(char const* configFileName, char const* configTimeStampFlag, char const* mode)
@@ -324,36 +460,48 @@ FILE* Log::openGmlogPerAccount(uint32 account)
     return fopen(namebuf, "a");
 }
 
+// localtime() shares one static result, the writer thread formats timestamps concurrently
+static tm LocalTime(time_t t)
+{
+    tm result;
+#if PLATFORM == PLATFORM_WINDOWS
+    localtime_s(&result, &t);
+#else
+    localtime_r(&t, &result);
+#endif
+    return result;
+}
+
 void Log::outTimestamp(FILE* file)
 {
     time_t t = time(nullptr);
-    tm* aTm = localtime(&t);
+    tm aTm = LocalTime(t);
     //       YYYY   year
     //       MM     month (2 digits 01-12)
     //       DD     day (2 digits 01-31)
     //       HH     hour (2 digits 00-23)
     //       MM     minutes (2 digits 00-59)
     //       SS     seconds (2 digits 00-59)
-    fprintf(file, "%-4d-%02d-%02d %02d:%02d:%02d ", aTm->tm_year + 1900, aTm->tm_mon + 1, aTm->tm_mday, aTm->tm_hour, aTm->tm_min, aTm->tm_sec);
+    fprintf(file, "%-4d-%02d-%02d %02d:%02d:%02d ", aTm.tm_year + 1900, aTm.tm_mon + 1, aTm.tm_mday, aTm.tm_hour, aTm.tm_min, aTm.tm_sec);
 }
 
 void Log::outTime() const
 {
     time_t t = time(nullptr);
-    tm* aTm = localtime(&t);
+    tm aTm = LocalTime(t);
     //       YYYY   year
     //       MM     month (2 digits 01-12)
     //       DD     day (2 digits 01-31)
     //       HH     hour (2 digits 00-23)
     //       MM     minutes (2 digits 00-59)
     //       SS     seconds (2 digits 00-59)
-    printf("%02d:%02d:%02d ", aTm->tm_hour, aTm->tm_min, aTm->tm_sec);
+    printf("%02d:%02d:%02d ", aTm.tm_hour, aTm.tm_min, aTm.tm_sec);
 }
 
 std::string Log::GetTimestampStr()
 {
     time_t t = time(nullptr);
-    tm* aTm = localtime(&t);
+    tm aTm = LocalTime(t);
     //       YYYY   year
     //       MM     month (2 digits 01-12)
     //       DD     day (2 digits 01-31)
@@ -361,207 +509,283 @@ std::string Log::GetTimestampStr()
     //       MM     minutes (2 digits 00-59)
     //       SS     seconds (2 digits 00-59)
     char buf[20];
-    snprintf(buf, 20, "%04d-%02d-%02d_%02d-%02d-%02d", aTm->tm_year + 1900, aTm->tm_mon + 1, aTm->tm_mday, aTm->tm_hour, aTm->tm_min, aTm->tm_sec);
+    snprintf(buf, 20, "%04d-%02d-%02d_%02d-%02d-%02d", aTm.tm_year + 1900, aTm.tm_mon + 1, aTm.tm_mday, aTm.tm_hour, aTm.tm_min, aTm.tm_sec);
     return std::string(buf);
 }
 
-void Log::outString()
+// formats into a per thread buffer, so callers don't allocate for every line
+static char const* FormatLogText(char const* format, va_list ap)
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_includeTime)
-        outTime();
-    printf("\n");
-    if (logfile)
+    static thread_local std::vector<char> buffer(1024);
+
+    va_list apCopy;
+    va_copy(apCopy, ap);
+    int length = vsnprintf(buffer.data(), buffer.size(), format, apCopy);
+    va_end(apCopy);
+
+    if (length < 0)
+    {
+        buffer[0] = '\0';
+        return buffer.data();
+    }
+
+    if (size_t(length) >= buffer.size())
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "\n");
-        fflush(logfile);
+        buffer.resize(length + 1);
+        vsnprintf(buffer.data(), buffer.size(), format, ap);
     }
 
-    fflush(stdout);
+    return buffer.data();
 }
 
-void Log::outString(const char* str, ...)
+static void WriteTimestamp(FILE* file, time_t t)
 {
-    if (!str)
+    tm aTm = LocalTime(t);
+    fprintf(file, "%-4d-%02d-%02d %02d:%02d:%02d ", aTm.tm_year + 1900, aTm.tm_mon + 1, aTm.tm_mday, aTm.tm_hour, aTm.tm_min, aTm.tm_sec);
+}
+
+void Log::StartAsyncWriter()
+{
+    if (m_asyncWriter.joinable())
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
+    if (!m_asyncQueue)
+        m_asyncQueue = new LogQueue(LOG_QUEUE_SIZE);
 
-    if (m_colored)
-        SetColor(true, m_colors[LogNormal]);
+    m_stopAsyncWriter = false;
+    m_asyncWriter = std::thread(&Log::AsyncWriterLoop, this);
+    m_async = true;
+}
 
-    if (m_includeTime)
-        outTime();
+bool Log::StopAsyncWriter()
+{
+    if (!m_asyncWriter.joinable())
+        return false;
+
+    // new lines are written directly from now on, the writer drains the queue before it stops
+    m_async = false;
+    m_stopAsyncWriter = true;
+    m_asyncWriter.join();
+
+    // producers that saw the writer running can still be enqueuing, their records point to files
+    // that may be closed right after this call, so all of them are written before returning
+    std::lock_guard<std::mutex> guard(m_fileLogMtx);
+    while (m_asyncProducers)
+    {
+        if (!WriteQueuedRecords())
+            std::this_thread::yield();
+    }
+    WriteQueuedRecords();
+    return true;
+}
 
-    va_list ap;
+void Log::AsyncWriterLoop()
+{
+    for (;;)
+    {
+        bool stop = m_stopAsyncWriter;
 
-    va_start(ap, str);
-    vutf8printf(stdout, str, &ap);
-    va_end(ap);
+        uint32 written;
+        {
+            std::lock_guard<std::mutex> guard(m_fileLogMtx);
+            written = WriteQueuedRecords();
+        }
 
-    if (m_colored)
-        ResetColor(true);
+        if (stop)
+            break;
 
-    printf("\n");
+        if (!written)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
 
-    if (logfile)
+uint32 Log::WriteQueuedRecords()
+{
+    uint32 written = 0;
+    std::vector<FILE*> flushFiles;
+
+    while (LogRecord const* record = m_asyncQueue->Front())
     {
-        outTimestamp(logfile);
+        if (record->file)
+        {
+            WriteRecord(record->file, record->time, record->text.c_str());
+            if (std::find(flushFiles.begin(), flushFiles.end(), record->file) == flushFiles.end())
+                flushFiles.push_back(record->file);
+        }
+        else if (FILE* perFile = openGmlogPerAccount(record->account))
+        {
+            WriteRecord(perFile, record->time, record->text.c_str());
+            fclose(perFile);
+        }
+
+        m_asyncQueue->Pop();
+        ++written;
+    }
 
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
-        va_end(ap);
+    // flush once per batch instead of once per line
+    for (FILE* file : flushFiles)
+        fflush(file);
 
-        fflush(logfile);
+    // wake producers waiting for a free cell
+    if (written)
+    {
+        std::lock_guard<std::mutex> guard(m_queueSpaceMtx);
+        m_queueSpaceCond.notify_all();
     }
 
-    fflush(stdout);
+    return written;
 }
 
-void Log::outError(const char* err, ...)
+void Log::WaitForQueueSpace()
 {
-    if (!err)
-        return;
-
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-
-    if (m_colored)
-        SetColor(false, m_colors[LogError]);
+    // the timeout covers a writer that was stopped meanwhile, the stopping thread drains the queue itself
+    std::unique_lock<std::mutex> lock(m_queueSpaceMtx);
+    m_queueSpaceCond.wait_for(lock, std::chrono::milliseconds(5));
+}
 
-    if (m_includeTime)
-        outTime();
+void Log::WriteRecord(FILE* file, time_t time, char const* text)
+{
+    if (time)
+        WriteTimestamp(file, time);
 
-    va_list ap;
+    fputs(text, file);
+    fputc('\n', file);
+}
 
-    va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
-    va_end(ap);
+void Log::WriteToFile(FILE* file, char const* prefix, char const* text, bool timestamp /*= true*/)
+{
+    if (!file)
+        return;
 
-    if (m_colored)
-        ResetColor(false);
+    time_t now = timestamp ? time(nullptr) : 0;
 
-    fprintf(stderr, "\n");
-    if (logfile)
+    ++m_asyncProducers;                                     // announced before m_async is read, see StopAsyncWriter
+    if (m_async)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:");
-
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
+        while (!m_asyncQueue->Enqueue(file, 0, now, prefix, text))
+            WaitForQueueSpace();
+        --m_asyncProducers;
+        return;
     }
-
-    fflush(stderr);
+    --m_asyncProducers;
+
+    std::lock_guard<std::mutex> guard(m_fileLogMtx);
+    if (now)
+        WriteTimestamp(file, now);
+    fputs(prefix, file);
+    fputs(text, file);
+    fputc('\n', file);
+    fflush(file);
 }
 
-void Log::outErrorDb()
+void Log::WriteToGmLog(uint32 account, char const* text)
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-
-    if (m_includeTime)
-        outTime();
-
-    fprintf(stderr, "\n");
-
-    if (logfile)
+    if (!m_gmlog_per_account)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:\n");
-        fflush(logfile);
+        WriteToFile(gmLogfile, "", text);
+        return;
     }
 
-    if (dberLogfile)
+    ++m_asyncProducers;
+    if (m_async)
     {
-        outTimestamp(dberLogfile);
-        fprintf(dberLogfile, "\n");
-        fflush(dberLogfile);
+        while (!m_asyncQueue->Enqueue(nullptr, account, time(nullptr), "", text))
+            WaitForQueueSpace();
+        --m_asyncProducers;
+        return;
     }
+    --m_asyncProducers;
 
-    fflush(stderr);
+    std::lock_guard<std::mutex> guard(m_fileLogMtx);
+    if (FILE* perFile = openGmlogPerAccount(account))
+    {
+        WriteRecord(perFile, time(nullptr), text);
+        fclose(perFile);
+    }
 }
 
-void Log::outErrorDb(const char* err, ...)
+void Log::WriteToConsole(bool stdout_stream, Color color, char const* text)
 {
-    if (!err)
-        return;
+    FILE* out = stdout_stream ? stdout : stderr;
 
     std::lock_guard<std::mutex> guard(m_worldLogMtx);
 
     if (m_colored)
-        SetColor(false, m_colors[LogError]);
+        SetColor(stdout_stream, color);
 
     if (m_includeTime)
         outTime();
 
-    va_list ap;
-
-    va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
-    va_end(ap);
+    utf8printf(out, "%s", text);
 
     if (m_colored)
-        ResetColor(false);
+        ResetColor(stdout_stream);
 
-    fprintf(stderr, "\n");
+    fprintf(out, "\n");
+    fflush(out);
+}
 
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:");
+void Log::outString()
+{
+    WriteToConsole(true, m_colors[LogNormal], "");
+    WriteToFile(logfile, "", "");
+}
 
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
+void Log::outString(const char* str, ...)
+{
+    if (!str)
+        return;
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
+    va_list ap;
+    va_start(ap, str);
+    char const* text = FormatLogText(str, ap);
+    va_end(ap);
 
-    if (dberLogfile)
-    {
-        outTimestamp(dberLogfile);
+    WriteToConsole(true, m_colors[LogNormal], text);
+    WriteToFile(logfile, "", text);
+}
 
-        va_list ap;
-        va_start(ap, err);
-        vfprintf(dberLogfile, err, ap);
-        va_end(ap);
+void Log::outError(const char* err, ...)
+{
+    if (!err)
+        return;
 
-        fprintf(dberLogfile, "\n");
-        fflush(dberLogfile);
-    }
+    va_list ap;
+    va_start(ap, err);
+    char const* text = FormatLogText(err, ap);
+    va_end(ap);
 
-    fflush(stderr);
+    WriteToConsole(false, m_colors[LogError], text);
+    WriteToFile(logfile, "ERROR:", text);
 }
 
-void Log::outErrorEventAI()
+void Log::outErrorDb()
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-
-    if (m_includeTime)
-        outTime();
+    WriteToConsole(false, m_colors[LogError], "");
+    WriteToFile(logfile, "ERROR:", "");
+    WriteToFile(dberLogfile, "", "");
+}
 
-    fprintf(stderr, "\n");
+void Log::outErrorDb(const char* err, ...)
+{
+    if (!err)
+        return;
 
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR CreatureEventAI\n");
-        fflush(logfile);
-    }
+    va_list ap;
+    va_start(ap, err);
+    char const* text = FormatLogText(err, ap);
+    va_end(ap);
 
-    if (eventAiErLogfile)
-    {
-        outTimestamp(eventAiErLogfile);
-        fprintf(eventAiErLogfile, "\n");
-        fflush(eventAiErLogfile);
-    }
+    WriteToConsole(false, m_colors[LogError], text);
+    WriteToFile(logfile, "ERROR:", text);
+    WriteToFile(dberLogfile, "", text);
+}
 
-    fflush(stderr);
+void Log::outErrorEventAI()
+{
+    WriteToConsole(false, m_colors[LogError], "");
+    WriteToFile(logfile, "ERROR CreatureEventAI", "");
+    WriteToFile(eventAiErLogfile, "", "");
 }
 
 void Log::outErrorEventAI(const char* err, ...)
@@ -569,51 +793,14 @@ void Log::outErrorEventAI(const char* err, ...)
     if (!err)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_colored)
-        SetColor(false, m_colors[LogError]);
-
-    if (m_includeTime)
-        outTime();
-
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    char const* text = FormatLogText(err, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(false);
-
-    fprintf(stderr, "\n");
-
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR CreatureEventAI: ");
-
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
-
-    if (eventAiErLogfile)
-    {
-        outTimestamp(eventAiErLogfile);
-
-        va_list ap;
-        va_start(ap, err);
-        vfprintf(eventAiErLogfile, err, ap);
-        va_end(ap);
-
-        fprintf(eventAiErLogfile, "\n");
-        fflush(eventAiErLogfile);
-    }
-
-    fflush(stderr);
+    WriteToConsole(false, m_colors[LogError], text);
+    WriteToFile(logfile, "ERROR CreatureEventAI: ", text);
+    WriteToFile(eventAiErLogfile, "", text);
 }
 
 void Log::outBasic(const char* str, ...)
@@ -621,38 +808,21 @@ void Log::outBasic(const char* str, ...)
     if (!str)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_logLevel >= LOG_LVL_BASIC)
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LogDetails]);
-
-        if (m_includeTime)
-            outTime();
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
-
-        if (m_colored)
-            ResetColor(true);
+    bool toConsole = m_logLevel >= LOG_LVL_BASIC;
+    bool toFile = logfile && m_logFileLevel >= LOG_LVL_BASIC;
+    if (!toConsole && !toFile)
+        return;
 
-        printf("\n");
-    }
+    va_list ap;
+    va_start(ap, str);
+    char const* text = FormatLogText(str, ap);
+    va_end(ap);
 
-    if (logfile && m_logFileLevel >= LOG_LVL_BASIC)
-    {
-        va_list ap;
-        outTimestamp(logfile);
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
-        va_end(ap);
-        fflush(logfile);
-    }
+    if (toConsole)
+        WriteToConsole(true, m_colors[LogDetails], text);
 
-    fflush(stdout);
+    if (toFile)
+        WriteToFile(logfile, "", text);
 }
 
 void Log::outDetail(const char* str, ...)
@@ -660,40 +830,21 @@ void Log::outDetail(const char* str, ...)
     if (!str)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_logLevel >= LOG_LVL_DETAIL)
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LogDetails]);
-
-        if (m_includeTime)
-            outTime();
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
-
-        if (m_colored)
-            ResetColor(true);
-
-        printf("\n");
-    }
-
-    if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
-    {
-        outTimestamp(logfile);
+    bool toConsole = m_logLevel >= LOG_LVL_DETAIL;
+    bool toFile = logfile && m_logFileLevel >= LOG_LVL_DETAIL;
+    if (!toConsole && !toFile)
+        return;
 
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        va_end(ap);
+    va_list ap;
+    va_start(ap, str);
+    char const* text = FormatLogText(str, ap);
+    va_end(ap);
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
+    if (toConsole)
+        WriteToConsole(true, m_colors[LogDetails], text);
 
-    fflush(stdout);
+    if (toFile)
+        WriteToFile(logfile, "", text);
 }
 
 void Log::outDebug(const char* str, ...)
@@ -701,40 +852,21 @@ void Log::outDebug(const char* str, ...)
     if (!str)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_logLevel >= LOG_LVL_DEBUG)
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LogDebug]);
-
-        if (m_includeTime)
-            outTime();
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
-
-        if (m_colored)
-            ResetColor(true);
-
-        printf("\n");
-    }
-
-    if (logfile && m_logFileLevel >= LOG_LVL_DEBUG)
-    {
-        outTimestamp(logfile);
+    bool toConsole = m_logLevel >= LOG_LVL_DEBUG;
+    bool toFile = logfile && m_logFileLevel >= LOG_LVL_DEBUG;
+    if (!toConsole && !toFile)
+        return;
 
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        va_end(ap);
+    va_list ap;
+    va_start(ap, str);
+    char const* text = FormatLogText(str, ap);
+    va_end(ap);
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
+    if (toConsole)
+        WriteToConsole(true, m_colors[LogDebug], text);
 
-    fflush(stdout);
+    if (toFile)
+        WriteToFile(logfile, "", text);
 }
 
 void Log::outCommand(uint32 account, const char* str, ...)
@@ -742,108 +874,44 @@ void Log::outCommand(uint32 account, const char* str, ...)
     if (!str)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_logLevel >= LOG_LVL_DETAIL)
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LogDetails]);
-
-        if (m_includeTime)
-            outTime();
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
-
-        if (m_colored)
-            ResetColor(true);
-
-        printf("\n");
-    }
+    va_list ap;
+    va_start(ap, str);
+    char const* text = FormatLogText(str, ap);
+    va_end(ap);
 
-    if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
-    {
-        va_list ap;
-        outTimestamp(logfile);
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
-        va_end(ap);
-        fflush(logfile);
-    }
+    if (m_logLevel >= LOG_LVL_DETAIL)
+        WriteToConsole(true, m_colors[LogDetails], text);
 
-    if (m_gmlog_per_account)
-    {
-        if (FILE* per_file = openGmlogPerAccount(account))
-        {
-            va_list ap;
-            outTimestamp(per_file);
-            va_start(ap, str);
-            vfprintf(per_file, str, ap);
-            fprintf(per_file, "\n");
-            va_end(ap);
-            fclose(per_file);
-        }
-    }
-    else if (gmLogfile)
-    {
-        va_list ap;
-        outTimestamp(gmLogfile);
-        va_start(ap, str);
-        vfprintf(gmLogfile, str, ap);
-        fprintf(gmLogfile, "\n");
-        va_end(ap);
-        fflush(gmLogfile);
-    }
+    if (m_logFileLevel >= LOG_LVL_DETAIL)
+        WriteToFile(logfile, "", text);
 
-    fflush(stdout);
+    WriteToGmLog(account, text);
 }
 
 void Log::outChar(const char* str, ...)
 {
-    if (!str)
+    if (!str || !charLogfile)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (charLogfile)
-    {
-        va_list ap;
-        outTimestamp(charLogfile);
-        va_start(ap, str);
-        vfprintf(charLogfile, str, ap);
-        fprintf(charLogfile, "\n");
-        va_end(ap);
-        fflush(charLogfile);
-    }
+    va_list ap;
+    va_start(ap, str);
+    char const* text = FormatLogText(str, ap);
+    va_end(ap);
+
+    WriteToFile(charLogfile, "", text);
 }
 
 void Log::outErrorScriptLib()
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_includeTime)
-        outTime();
-
-    fprintf(stderr, "\n");
+    WriteToConsole(false, m_colors[LogError], "");
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        if (m_scriptLibName)
-            fprintf(logfile, "<%s ERROR:> ", m_scriptLibName);
-        else
-            fprintf(logfile, "<Scripting Library ERROR>: ");
-        fflush(logfile);
-    }
-
-    if (scriptErrLogFile)
-    {
-        outTimestamp(scriptErrLogFile);
-        fprintf(scriptErrLogFile, "\n");
-        fflush(scriptErrLogFile);
+        std::string prefix = m_scriptLibName ? std::string("<") + m_scriptLibName + " ERROR>: " : "<Scripting Library ERROR>: ";
+        WriteToFile(logfile, prefix.c_str(), "");
     }
 
-    fflush(stderr);
+    WriteToFile(scriptErrLogFile, "", "");
 }
 
 void Log::outErrorScriptLib(const char* err, ...)
@@ -851,54 +919,20 @@ void Log::outErrorScriptLib(const char* err, ...)
     if (!err)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (m_colored)
-        SetColor(false, m_colors[LogError]);
-
-    if (m_includeTime)
-        outTime();
-
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    char const* text = FormatLogText(err, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(false);
-
-    fprintf(stderr, "\n");
+    WriteToConsole(false, m_colors[LogError], text);
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        if (m_scriptLibName)
-            fprintf(logfile, "<%s ERROR>: ", m_scriptLibName);
-        else
-            fprintf(logfile, "<Scripting Library ERROR>: ");
-
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
-
-    if (scriptErrLogFile)
-    {
-        outTimestamp(scriptErrLogFile);
-
-        va_list ap;
-        va_start(ap, err);
-        vfprintf(scriptErrLogFile, err, ap);
-        va_end(ap);
-
-        fprintf(scriptErrLogFile, "\n");
-        fflush(scriptErrLogFile);
+        std::string prefix = m_scriptLibName ? std::string("<") + m_scriptLibName + " ERROR>: " : "<Scripting Library ERROR>: ";
+        WriteToFile(logfile, prefix.c_str(), text);
     }
 
-    fflush(stderr);
+    WriteToFile(scriptErrLogFile, "", text);
 }
 
 void Log::outWorldPacketDump(const char* socket, uint32 opcode, char const* opcodeName, ByteBuffer const& packet, bool incoming)
@@ -906,76 +940,67 @@ void Log::outWorldPacketDump(const char* socket, uint32 opcode, char const* opco
     if (!worldLogfile)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
+    static char const hexDigits[] = "0123456789ABCDEF";
 
-    outTimestamp(worldLogfile);
+    // the hex dump is built by hand, one fprintf per byte was the most expensive part of the packet log
+    std::string dump;
+    dump.reserve(128 + packet.size() * 3 + packet.size() / 16);
 
-    fprintf(worldLogfile, "\n%s:\nSOCKET: %s\nLENGTH: %u\nOPCODE: %s (0x%.4X)\nDATA:\n",
-            incoming ? "CLIENT" : "SERVER",
-            socket, static_cast<uint32>(packet.size()), opcodeName, opcode);
+    char header[256];
+    snprintf(header, sizeof(header), "\n%s:\nSOCKET: %s\nLENGTH: %u\nOPCODE: %s (0x%.4X)\nDATA:\n",
+             incoming ? "CLIENT" : "SERVER", socket, static_cast<uint32>(packet.size()), opcodeName, opcode);
+    dump.append(header);
 
-    size_t p = 0;
-    while (p < packet.size())
+    for (size_t p = 0; p < packet.size(); ++p)
     {
-        for (size_t j = 0; j < 16 && p < packet.size(); ++j)
-            fprintf(worldLogfile, "%.2X ", packet[p++]);
-
-        fprintf(worldLogfile, "\n");
+        uint8 byte = packet[p];
+        dump.push_back(hexDigits[byte >> 4]);
+        dump.push_back(hexDigits[byte & 0x0F]);
+        dump.push_back(' ');
+        if ((p % 16) == 15 || p + 1 == packet.size())
+            dump.push_back('\n');
     }
 
-    fprintf(worldLogfile, "\n\n");
-    fflush(worldLogfile);
+    dump.append("\n");
+
+    WriteToFile(worldLogfile, "", dump.c_str());
 }
 
 void Log::outCharDump(const char* str, uint32 account_id, uint32 guid, const char* name)
 {
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
+    if (!charLogfile)
+        return;
 
-    if (charLogfile)
-    {
-        fprintf(charLogfile, "== START DUMP == (account: %u guid: %u name: %s )\n%s\n== END DUMP ==\n", account_id, guid, name, str);
-        fflush(charLogfile);
-    }
+    std::ostringstream ss;
+    ss << "== START DUMP == (account: " << account_id << " guid: " << guid << " name: " << name << " )\n" << str << "\n== END DUMP ==";
+
+    WriteToFile(charLogfile, "", ss.str().c_str(), false);
 }
 
 void Log::outRALog(const char* str, ...)
 {
-    if (!str)
+    if (!str || !raLogfile)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (raLogfile)
-    {
-        va_list ap;
-        outTimestamp(raLogfile);
-        va_start(ap, str);
-        vfprintf(raLogfile, str, ap);
-        fprintf(raLogfile, "\n");
-        va_end(ap);
-        fflush(raLogfile);
-    }
+    va_list ap;
+    va_start(ap, str);
+    char const* text = FormatLogText(str, ap);
+    va_end(ap);
 
-    fflush(stdout);
+    WriteToFile(raLogfile, "", text);
 }
 
 void Log::outCustomLog(const char* str, ...)
 {
-    if (!str)
+    if (!str || !customLogFile)
         return;
 
-    std::lock_guard<std::mutex> guard(m_worldLogMtx);
-    if (customLogFile)
-    {
-        va_list ap;
-        outTimestamp(customLogFile);
-        va_start(ap, str);
-        vfprintf(customLogFile, str, ap);
-        fprintf(customLogFile, "\n");
-        va_end(ap);
-        fflush(customLogFile);
-    }
+    va_list ap;
+    va_start(ap, str);
+    char const* text = FormatLogText(str, ap);
+    va_end(ap);
 
-    fflush(stdout);
+    WriteToFile(customLogFile, "", text);
 }
 
 void Log::WaitBeforeContinueIfNeed()
@@ -1003,20 +1028,24 @@ void Log::WaitBeforeContinueIfNeed()
 
 void Log::setScriptLibraryErrorFile(char const* fname, char const* libName)
 {
+    // queued lines may still reference the old file
+    bool async = StopAsyncWriter();
+
     m_scriptLibName = libName;
 
     if (scriptErrLogFile)
         fclose(scriptErrLogFile);
 
-    if (!fname)
+    scriptErrLogFile = nullptr;
+    if (fname)
     {
-        scriptErrLogFile = nullptr;
-        return;
+        std::string fileName = m_logsDir;
+        fileName.append(fname);
+        scriptErrLogFile = fopen(fileName.c_str(), "a");
     }
 
-    std::string fileName = m_logsDir;
-    fileName.append(fname);
-    scriptErrLogFile = fopen(fileName.c_str(), "a");
+    if (async)
+        StartAsyncWriter();
 }
 
 void outstring_log()
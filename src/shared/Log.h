@@ -23,9 +23,13 @@
 #include "Policies/Singleton.h"
 
 #include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
 
 class Config;
 class ByteBuffer;
+class LogQueue;
 
 enum LogLevel
 {
@@ -96,44 +100,8 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
         friend class MaNGOS::OperatorNew<Log>;
         Log();
 
-        ~Log()
-        {
-            if (logfile != nullptr)
-                fclose(logfile);
-            logfile = nullptr;
+        ~Log();
 
-            if (gmLogfile != nullptr)
-                fclose(gmLogfile);
-            gmLogfile = nullptr;
-
-            if (charLogfile != nullptr)
-                fclose(charLogfile);
-            charLogfile = nullptr;
-
-            if (dberLogfile != nullptr)
-                fclose(dberLogfile);
-            dberLogfile = nullptr;
-
-            if (eventAiErLogfile != nullptr)
-                fclose(eventAiErLogfile);
-            eventAiErLogfile = nullptr;
-
-            if (scriptErrLogFile != nullptr)
-                fclose(scriptErrLogFile);
-            scriptErrLogFile = nullptr;
-
-            if (raLogfile != nullptr)
-                fclose(raLogfile);
-            raLogfile = nullptr;
-
-            if (worldLogfile != nullptr)
-                fclose(worldLogfile);
-            worldLogfile = nullptr;
-
-            if (customLogFile != nullptr)
-                fclose(customLogFile);
-            customLogFile = nullptr;
-        }
     public:
         void Initialize();
         void InitColors(const std::string& init_str);
@@ -193,6 +161,20 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
         FILE* openLogFile(char const* configFileName, char const* configTimeStampFlag, char const* mode);
         FILE* openGmlogPerAccount(uint32 account);
 
+        void WriteToConsole(bool stdout_stream, Color color, char const* text);
+        // queued for the writer thread in async mode, written and flushed directly otherwise
+        void WriteToFile(FILE* file, char const* prefix, char const* text, bool timestamp = true);
+        void WriteToGmLog(uint32 account, char const* text);
+
+        void StartAsyncWriter();
+        // writes all queued lines, returns true if the writer was running
+        bool StopAsyncWriter();
+        void AsyncWriterLoop();
+        uint32 WriteQueuedRecords();
+        // blocks a producer until the writer made room in the full queue
+        void WaitForQueueSpace();
+        static void WriteRecord(FILE* file, time_t time, char const* text);
+
         FILE* raLogfile;
         FILE* logfile;
         FILE* gmLogfile;
@@ -202,7 +184,17 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
         FILE* scriptErrLogFile;
         FILE* worldLogfile;
         FILE* customLogFile;
-        std::mutex m_worldLogMtx;
+        std::mutex m_worldLogMtx;                           // console output
+        std::mutex m_fileLogMtx;                            // file output, taken by the writer thread in async mode
+
+        // async file output
+        LogQueue* m_asyncQueue;
+        std::thread m_asyncWriter;
+        std::atomic<bool> m_async;
+        std::atomic<bool> m_stopAsyncWriter;
+        std::atomic<uint32> m_asyncProducers;               // threads between the m_async check and their enqueue
+        std::mutex m_queueSpaceMtx;
+        std::condition_variable m_queueSpaceCond;           // signaled by the writer after it emptied the queue
 
         // log/console control
         LogLevel m_logLevel;